@@ -5,12 +5,25 @@ include build_support/common_dirs.mak
 include build_support/hrtim_trig.mak
 include build_support/project_parts.mak
 include build_support/generator.mak
+include build_support/tools.mak
 
 PHONIES 			?=
 HABMASTER_BIN_NAME 	:= $(HAB_OUT_BIN_PATH)/hab_master
 GPP_ARG_INCLUDE 	:= $(foreach header,$(HAB_INCLUDE_LIST),-I$(header))
 GPP_ARG_PREPROC     := $(HABDEV_MACRO_LIST) \
 						-DHAB_DEV_NAME='$(DEV_NAMES)' \
+						-DHAB_DEV_IIO_MATCH='$(DEV_IIO_MATCH)' \
+						-DHAB_DEV_LOG_FMT='$(DEV_LOG_FMT)' \
+						-DHAB_DEV_LOG_PRIO='$(DEV_LOG_PRIO)' \
+						-DHAB_STORAGE_MODE=$(HAB_STORAGE_MODE) \
+						-DHAB_STORAGE_BLOCK_KB=$(HAB_STORAGE_BLOCK_KB) \
+						-DHAB_BUDGET_HORIZON_S=$(HAB_BUDGET_HORIZON_S) \
+						-DHAB_BUDGET_RESERVE_MB=$(HAB_BUDGET_RESERVE_MB) \
+						-DHAB_IO_MEDIA_KBPS=$(HAB_IO_MEDIA_KBPS) \
+						-DHAB_IO_MEDIA_BURST_MB=$(HAB_IO_MEDIA_BURST_MB) \
+						-DHAB_ZIP_METHOD=$(HAB_ZIP_METHOD) \
+						-DHAB_ZIP_LEVEL=$(HAB_ZIP_LEVEL) \
+						-DHAB_ZIP_CPU_PCT=$(HAB_ZIP_CPU_PCT) \
 						$(HABDEV_CB_NAME_LIST) \
 						-DHAB_CALLBACKS='$(CB_LIST)' \
 						-DHABDEV_IDX_SET='$(HABDEV_IDX_ARRAY)' \
@@ -18,13 +31,19 @@ GPP_ARG_PREPROC     := $(HABDEV_MACRO_LIST) \
 						-DTRIG_LUT='$(TRIG_LUT_ARRAY)' \
 						-DEV_TIM_DEV_IDX='$(TIMER_EV_DEV_IDX)' \
 						-DHAB_DEV_CFG_PATH=$(call to_string,$(HAB_DEV_CFG_PATH)/) \
-						-DHAB_G_EV_CFG_PATH=$(call to_string,$(HAB_G_EV_CFG_PATH)/)
+						-DHAB_G_EV_CFG_PATH=$(call to_string,$(HAB_G_EV_CFG_PATH)/) \
+						-DBOOT_KMOD_SET='$(BOOT_KMOD_NAMES)' \
+						-DBOOT_MDT_KMOD_SET='$(BOOT_MDT_KMOD_NAMES)' \
+						-DBOOT_IIO_KMOD_SET='$(BOOT_IIO_KMOD_NAMES)' \
+						-DBOOT_KMOD_PATH=$(call to_string,$(HAB_OUT_KLIB_PATH)/) \
+						-DBOOT_DTOVERLAY_PATH=$(call to_string,$(HAB_OUT_DTOVERLAY_PATH)/) \
+						-DBOOT_CONFIGFS_PATH=$(call to_string,$(dir $(CONFIGFS_DT_PATH)))
 
 
 build_all_hab: $(HABMASTER_BIN_NAME)
 $(HABMASTER_BIN_NAME): $(HAB_SRC_LIST)
 	@mkdir -p $(dir $(HABMASTER_BIN_NAME))
-	@gcc -o $(HABMASTER_BIN_NAME) $(HAB_SRC_LIST) $(GPP_ARG_INCLUDE) $(GPP_ARG_PREPROC) -luv -g
+	@gcc -o $(HABMASTER_BIN_NAME) $(HAB_SRC_LIST) $(GPP_ARG_INCLUDE) $(GPP_ARG_PREPROC) -luv -lpthread -lrt -lm $(HAB_ZIP_LIBS) -g
 PHONIES += build_all_hab
 
 PHONIES += test_print
@@ -36,5 +55,10 @@ test_print:
 	@echo HABDEV_CB_NAME_LIST: $(HABDEV_CB_NAME_LIST)
 	@echo CB_LIST: $(CB_LIST)
 	@echo DEVICE_NAME: $(DEV_NAMES)
+	@echo DEV_IIO_MATCH: $(DEV_IIO_MATCH)
+	@echo DEV_LOG_FMT: $(DEV_LOG_FMT)
+	@echo DEV_LOG_PRIO: $(DEV_LOG_PRIO)
+	@echo BOOT_KMOD_NAMES: $(BOOT_KMOD_NAMES)
+	@echo BOOT_IIO_KMOD_NAMES: $(BOOT_IIO_KMOD_NAMES)
 
 PHONY: $(PHONIES)
@@ -49,7 +49,7 @@ HABDEV_LIST := $(HABDEV_MPRLS) \
 # DEVICE-EVENT HASHTABLE
 ########################################################################################################################
 $(HABDEV_MPRLS)_EV 			:= $(TIM_CB)
-# $(HABDEV_ICM20948)_EV 		:= $(TIM_CB)
+$(HABDEV_ICM20948)_EV 		:= $(TIM_CB)
 $(HABDEV_SHT40)_EV 			:= $(TIM_CB)
 $(HABDEV_ADS1115_48)_EV 	:= $(TIM_CB)
 $(HABDEV_ADS1115_49)_EV 	:= $(TIM_CB)
@@ -60,6 +60,7 @@ $(HABDEV_CAM_2)_EV 			:= $(TIM_CB)
 ########################################################################################################################
 # TRIGGER LIST
 ########################################################################################################################
+TRIG_100   := _100
 TRIG_500   := _500
 TRIG_1000  := _1000
 TRIG_5000  := _5000
@@ -70,13 +71,93 @@ TRIG_0     := _0
 ########################################################################################################################
 # DEVICE-TRIGGER HASHTABLE
 ########################################################################################################################
-$(HABDEV_MPRLS)_TRIG 		:= $(TRIG_10000)
+$(HABDEV_MPRLS)_TRIG 		:= $(TRIG_1000)
 $(HABDEV_ICM20948)_TRIG 	:= $(TRIG_5000)
 $(HABDEV_SHT40)_TRIG 		:= $(TRIG_10000)
-$(HABDEV_ADS1115_48)_TRIG 	:= $(TRIG_5000)
-$(HABDEV_ADS1115_49)_TRIG 	:= $(TRIG_5000)
+$(HABDEV_ADS1115_48)_TRIG 	:= $(TRIG_100)
+$(HABDEV_ADS1115_49)_TRIG 	:= $(TRIG_100)
 $(HABDEV_MLX90614)_TRIG 	:= $(TRIG_10000)
 
+########################################################################################################################
+# DEVICE-IIO MATCH HASHTABLE
+########################################################################################################################
+# Format: <iio name>[@<i2c address>]. A device whose DT label equals the device name matches as well.
+$(HABDEV_MPRLS)_IIO 		:= mprls0025
+$(HABDEV_ICM20948)_IIO 		:= icm20x
+$(HABDEV_SHT40)_IIO 		:= sht4x
+$(HABDEV_ADS1115_48)_IIO 	:= ads1115@48
+$(HABDEV_ADS1115_49)_IIO 	:= ads1115@49
+$(HABDEV_AD5272_2C)_IIO 	:= ad5272-050@2c
+$(HABDEV_AD5272_2E)_IIO 	:= ad5272-050@2e
+$(HABDEV_AD5272_2F)_IIO 	:= ad5272-050@2f
+$(HABDEV_MLX90614)_IIO 		:= mlx90614
+
+########################################################################################################################
+# DEVICE-LOG FORMAT HASHTABLE
+########################################################################################################################
+# Values are aligned with logfmt_t in log_codec.h. Devices without an entry are logged as a hexdump.
+# ZIP logs the raw scan records through the compression stage.
+LOGFMT_HEX   := 0
+LOGFMT_DELTA := 1
+LOGFMT_ZIP   := 2
+
+$(HABDEV_MPRLS)_LOGFMT 		:= $(LOGFMT_DELTA)
+$(HABDEV_SHT40)_LOGFMT 		:= $(LOGFMT_DELTA)
+$(HABDEV_MLX90614)_LOGFMT 	:= $(LOGFMT_DELTA)
+$(HABDEV_ICM20948)_LOGFMT 	:= $(LOGFMT_ZIP)
+
+########################################################################################################################
+# LOG COMPRESSION
+########################################################################################################################
+# Values are aligned with logzip_method_t in log_zip.h. LZ4 needs liblz4, ZSTD needs libzstd on the target.
+ZIP_METHOD_STORED := 0
+ZIP_METHOD_LZ4    := 1
+ZIP_METHOD_ZSTD   := 2
+
+HAB_ZIP_METHOD := $(ZIP_METHOD_LZ4)
+# 1 - fastest, 9 - best ratio. zstd takes its own levels.
+HAB_ZIP_LEVEL := 1
+# Share of a core the compression worker may take before it stores blocks uncompressed
+HAB_ZIP_CPU_PCT := 50
+
+# liblz4 is linked either way, the decoder reads LZ4 blocks of any build
+HAB_ZIP_LIBS := -llz4 $(if $(call str-eq,$(HAB_ZIP_METHOD),$(ZIP_METHOD_ZSTD)),-lzstd,$(EMPTY))
+
+########################################################################################################################
+# DEVICE-LOG PRIORITY HASHTABLE
+########################################################################################################################
+# Values are aligned with budget_prio_t in storage_budget.h. Devices without an entry are high priority.
+# Low priority logs are decimated once the storage budget runs short.
+LOGPRIO_HIGH := 0
+LOGPRIO_LOW  := 1
+
+$(HABDEV_ICM20948)_LOGPRIO 	:= $(LOGPRIO_LOW)
+
+########################################################################################################################
+# LOG STORAGE
+########################################################################################################################
+# Values are aligned with storage_mode_t in storage.h.
+# STREAM - a log file per device opened in append mode.
+# MMAP   - preallocated log segments written through a memory mapping, rotated when full.
+# DIRECT - O_DIRECT writes of erase block sized, aligned blocks. Each log holds one block buffer in memory.
+STORAGE_MODE_STREAM := 0
+STORAGE_MODE_MMAP   := 1
+STORAGE_MODE_DIRECT := 2
+
+HAB_STORAGE_MODE := $(STORAGE_MODE_MMAP)
+
+# Erase block size of the storage card, used by the DIRECT mode
+HAB_STORAGE_BLOCK_KB := 4096
+
+# Storage budget. The data is expected to fit the card for HAB_BUDGET_HORIZON_S seconds of the mission,
+# HAB_BUDGET_RESERVE_MB of the free space is kept for sensor logs only.
+HAB_BUDGET_HORIZON_S  := 14400
+HAB_BUDGET_RESERVE_MB := 512
+
+# I/O shaping of the camera captures. Average media write rate and the burst a single capture may take.
+HAB_IO_MEDIA_KBPS     := 1024
+HAB_IO_MEDIA_BURST_MB := 16
+
 _TRIG_LIST = $(foreach elem,$(HABDEV_LIST),$($(elem)_TRIG))
 TRIG_LIST = $(call remove_repetition,$(_TRIG_LIST))
 
@@ -88,6 +169,18 @@ HABDEV_IDX_ARRAY 	= $(call create_array,$(call indexify,$(HABDEV_LIST)))
 _DEV_NAMES = $(foreach dev,$(HABDEV_LIST),\"$(dev)\")
 DEV_NAMES = $(call create_array,$(_DEV_NAMES))
 
+# IIO match strings, aligned with HABDEV_IDX_ARRAY. Used for resolving a device on the IIO bus.
+_DEV_IIO_MATCH = $(foreach dev,$(HABDEV_LIST),\"$($(dev)_IIO)\")
+DEV_IIO_MATCH = $(call create_array,$(_DEV_IIO_MATCH))
+
+# Log formats, aligned with HABDEV_IDX_ARRAY.
+_DEV_LOG_FMT = $(foreach dev,$(HABDEV_LIST),$(if $($(dev)_LOGFMT),$($(dev)_LOGFMT),$(LOGFMT_HEX)))
+DEV_LOG_FMT = $(call create_array,$(_DEV_LOG_FMT))
+
+# Log priorities, aligned with HABDEV_IDX_ARRAY.
+_DEV_LOG_PRIO = $(foreach dev,$(HABDEV_LIST),$(if $($(dev)_LOGPRIO),$($(dev)_LOGPRIO),$(LOGPRIO_HIGH)))
+DEV_LOG_PRIO = $(call create_array,$(_DEV_LOG_PRIO))
+
 # Trigger delay values. Used when registering trigger.
 TRIG_ARRAY 			= $(call create_array,$(subst _,$(EMPTY),$(TRIG_LIST)))
 
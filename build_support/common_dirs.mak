@@ -2,6 +2,7 @@ HAB_CORE_SRC_PATH := src/app/Appl/core
 HAB_CORE_INC_PATH := src/app/Include/core
 HAB_USR_SRC_PATH  := src/app/Appl/usr
 HAB_USR_INC_PATH  := src/app/Include/usr
+HAB_TOOLS_SRC_PATH := src/app/Appl/tools
 HAB_KLIB_PATH     := src/klib
 HAB_DEV_CFG_PATH  := src/cfg
 HAB_G_EV_CFG_PATH  := src/cfg/ev_glob
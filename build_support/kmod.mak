@@ -80,3 +80,18 @@ load_kmod: $(addsuffix .ko,$(HAB_KMOD_BASENAME_LIST))
 .PHONIES += setup_kernel_all
 setup_kernel_all: build_dtoverlay load_dtoverlay build_kmod load_kmod build_mdt_kmod load_mdt_kmod
 	@echo "INFO: Kernel setup finished. Modules loaded: $(HAB_KMOD_LIST) $(MDT_KMOD_LIST)."
+
+
+########################################################################################################################
+# BOOT MODE MACROS																									   #
+########################################################################################################################
+# Module names that hab_master loads itself when started with --boot.
+# Every module from HAB_KMOD_LIST has a dtoverlay with the same basename.
+_BOOT_KMOD_NAMES 	 = $(foreach kmod,$(HAB_KMOD_LIST),\"$(kmod)\")
+BOOT_KMOD_NAMES  	 = $(call create_array,$(_BOOT_KMOD_NAMES))
+
+_BOOT_MDT_KMOD_NAMES = $(foreach kmod,$(MDT_KMOD_LIST),\"$(kmod)\")
+BOOT_MDT_KMOD_NAMES  = $(call create_array,$(_BOOT_MDT_KMOD_NAMES))
+
+_BOOT_IIO_KMOD_NAMES = $(foreach kmod,$(IIO_KMOD_LIST) $(IIO_TRIG_HRTIM_MOD),\"$(kmod)\")
+BOOT_IIO_KMOD_NAMES  = $(call create_array,$(_BOOT_IIO_KMOD_NAMES))
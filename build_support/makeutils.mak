@@ -31,7 +31,7 @@ decrement  = $(shell echo "$$(($(1) - 1))")
 #         $(call get_word_idx,arm,x86 risc-v arm)
 #     OUTPUT:
 #         3
-_pos = $(if $(findstring $1,$2),$(call _pos,$1,\
+_pos = $(if $(filter $1,$2),$(call _pos,$1,\
        	$(wordlist 2,$(words $2),$2),x $3),$3)
 get_word_idx = $(words $(call _pos,$1,$2))
 
@@ -7,7 +7,14 @@ HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/event
 HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/common
 HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/stdtypes
 HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/hab_trig
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/hab_time
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/telemetry
 HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/iio_buffer_ops
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/uevent
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/iio_discovery
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/boot
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/log_codec
+HAB_INCLUDE_LIST 	+= $(HAB_CORE_INC_PATH)/storage
 
 # 2. GENERATED DATA HEADERS
 HAB_INCLUDE_LIST	+= $(HAB_OUT_GENERATED_PATH)
@@ -25,14 +32,33 @@ HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/event/event.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/event/callback.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/dfa.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/utils.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/crc32c.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/llist.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/cfg_tree.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/common/hab_device.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/hab_trig/hab_trig.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/hab_time/hab_time.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/hab_time/hab_clock.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/telemetry/telemetry.c
 HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_buffer_ops.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_scan.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_stats.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_capture.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_conv.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/uevent/uevent.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/iio_discovery/iio_discovery.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/boot/boot.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/log_codec/log_codec.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/log_codec/log_zip.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/log_codec/log_zip_block.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/storage/storage.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/storage/storage_budget.c
+HAB_SRC_LIST += $(HAB_CORE_SRC_PATH)/storage/storage_shaper.c
 
 # 2. USER APPLICATION SRC
 HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/camera.c
 HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/task_main.c
 HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/wheatstone.c
 HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/ff_detector.c
+HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/accel_mag.c
+HAB_SRC_LIST += $(HAB_USR_SRC_PATH)/alt_fusion.c
@@ -0,0 +1,83 @@
+########################################################################################################################
+# POST-FLIGHT TOOLS																									   #
+########################################################################################################################
+# Host side utilities working on the logs stored by hab_master. They reuse the core sources they depend on.
+HAB_TOOLS_INCLUDE_LIST := $(HAB_CORE_INC_PATH)/stdtypes \
+							$(HAB_CORE_INC_PATH)/common \
+							$(HAB_CORE_INC_PATH)/storage \
+							$(HAB_CORE_INC_PATH)/hab_time \
+							$(HAB_CORE_INC_PATH)/log_codec \
+							$(HAB_CORE_INC_PATH)/iio_buffer_ops \
+							$(HAB_CORE_INC_PATH)/telemetry \
+							$(HAB_USR_INC_PATH)
+
+HAB_TOOLS_ARG_INCLUDE := $(foreach header,$(HAB_TOOLS_INCLUDE_LIST),-I$(header))
+
+HAB_SEEK_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_seek
+HAB_SEEK_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_seek.c \
+						$(HAB_CORE_SRC_PATH)/storage/storage.c \
+						$(HAB_CORE_SRC_PATH)/hab_time/hab_clock.c \
+						$(HAB_CORE_SRC_PATH)/common/crc32c.c
+
+HAB_DECODE_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_decode
+HAB_DECODE_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_decode.c \
+						$(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_scan.c \
+						$(HAB_CORE_SRC_PATH)/log_codec/log_codec.c \
+						$(HAB_CORE_SRC_PATH)/log_codec/log_zip_block.c \
+						$(HAB_CORE_SRC_PATH)/storage/storage.c \
+						$(HAB_CORE_SRC_PATH)/hab_time/hab_clock.c \
+						$(HAB_CORE_SRC_PATH)/common/crc32c.c \
+						$(HAB_CORE_SRC_PATH)/common/utils.c
+
+HAB_MERGE_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_merge
+HAB_MERGE_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_merge.c
+
+HAB_TELEM_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_telem
+HAB_TELEM_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_telem.c \
+						$(HAB_CORE_SRC_PATH)/telemetry/telemetry_reader.c
+
+HAB_MAGBENCH_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_magbench
+HAB_MAGBENCH_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_magbench.c \
+							$(HAB_USR_SRC_PATH)/accel_mag.c
+
+HAB_CODECBENCH_BIN_NAME := $(HAB_OUT_BIN_PATH)/hab_codecbench
+HAB_CODECBENCH_SRC_LIST := $(HAB_TOOLS_SRC_PATH)/hab_codecbench.c \
+							$(HAB_CORE_SRC_PATH)/iio_buffer_ops/iio_scan.c \
+							$(HAB_CORE_SRC_PATH)/log_codec/log_codec.c \
+							$(HAB_CORE_SRC_PATH)/log_codec/log_zip_block.c \
+							$(HAB_CORE_SRC_PATH)/common/utils.c
+
+HAB_TOOLS_BIN_LIST := $(HAB_SEEK_BIN_NAME) \
+						$(HAB_DECODE_BIN_NAME) \
+						$(HAB_MERGE_BIN_NAME) \
+						$(HAB_TELEM_BIN_NAME) \
+						$(HAB_MAGBENCH_BIN_NAME) \
+						$(HAB_CODECBENCH_BIN_NAME)
+
+$(HAB_SEEK_BIN_NAME): $(HAB_SEEK_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_SEEK_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -g
+
+$(HAB_DECODE_BIN_NAME): $(HAB_DECODE_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_DECODE_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -DHAB_ZIP_METHOD=$(HAB_ZIP_METHOD) -lpthread $(HAB_ZIP_LIBS) -g
+
+$(HAB_MERGE_BIN_NAME): $(HAB_MERGE_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_MERGE_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -g
+
+$(HAB_TELEM_BIN_NAME): $(HAB_TELEM_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_TELEM_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -lrt -g
+
+# Optimized like the flight build would be, the numbers are meaningless at -O0
+$(HAB_MAGBENCH_BIN_NAME): $(HAB_MAGBENCH_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_MAGBENCH_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -O2 -g
+
+$(HAB_CODECBENCH_BIN_NAME): $(HAB_CODECBENCH_SRC_LIST)
+	@mkdir -p $(dir $@)
+	@gcc -o $@ $(HAB_CODECBENCH_SRC_LIST) $(HAB_TOOLS_ARG_INCLUDE) -DHAB_ZIP_METHOD=$(HAB_ZIP_METHOD) $(HAB_ZIP_LIBS) -g
+
+build_tools: $(HAB_TOOLS_BIN_LIST)
+PHONIES += build_tools
@@ -0,0 +1,321 @@
+/**********************************************************************************************************************
+* boot.cpp                                                                                                            *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Fast-boot orchestration. Replaces the sequential make based kernel setup:                                     *
+*         1. IIO core and hrtimer trigger modules are probed in parallel, configfs is mounted.                        *
+*         2. Device dtoverlays and kernel modules are loaded in parallel.                                             *
+*         3. Every expected IIO device is reported as soon as its uevent arrives, so acquisition                      *
+*            of a device does not wait for the slowest sensor.                                                        *
+*       Modules that are already loaded are skipped, which makes a warm restart free of any spawning.                 *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       void                boot_start(uv_loop_t *loop, const boot_ops_t *ops)                                        *
+*       void                boot_expectDev(const u32 dev_idx)                                                         *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mount.h>
+
+#include "boot.h"
+#include "utils.h"
+#include "uevent.h"
+#include "iio_discovery.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#ifndef BOOT_KMOD_PATH
+# error "ERROR: Path to kernel modules is not specified."
+#endif
+
+#define SYS_MODULE_PATH     "/sys/module/"
+#define IIO_SUBSYSTEM       "iio"
+
+#define BOOT_CMD_MODPROBE   "modprobe"
+#define BOOT_CMD_INSMOD     "insmod"
+#define BOOT_CMD_DTOVERLAY  "dtoverlay"
+
+#define BOOT_DEV_MAX        64
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    BOOT_PH_IDLE,
+    BOOT_PH_CORE,
+    BOOT_PH_DEVICES,
+    BOOT_PH_DONE,
+} boot_phase_t;
+
+typedef struct {
+    u32 idx;
+    bool ready;
+} boot_dev_t;
+
+typedef struct {
+    uv_process_t proc;
+    char what[128];
+} boot_proc_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const char *kmod_list[]     = BOOT_KMOD_SET;
+static const char *mdt_kmod_list[] = BOOT_MDT_KMOD_SET;
+static const char *iio_kmod_list[] = BOOT_IIO_KMOD_SET;
+
+static uv_loop_t *boot_loop;
+static const boot_ops_t *boot_ops;
+static boot_phase_t boot_phase;
+
+static boot_dev_t boot_dev_list[BOOT_DEV_MAX];
+static usize boot_dev_cnt;
+static usize boot_dev_ready_cnt;
+static usize spawn_pending;
+
+static uv_timer_t *boot_timer;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+static void start_devices(void);
+static void finish(void);
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static void on_handle_close(uv_handle_t *handle) {
+    free(handle);
+}
+
+static bool kmod_loaded(const char *kmod) {
+    struct stat st = {0};
+    char path_buff[128] = {0};
+    usize len = 0;
+
+    /* Module names use underscores inside /sys/module */
+    len = snprintf(path_buff, sizeof(path_buff), "%s%s", SYS_MODULE_PATH, kmod);
+    for (usize i = sizeof(SYS_MODULE_PATH) - 1; i < len && i < sizeof(path_buff); i++) {
+        if ('-' == path_buff[i])
+            path_buff[i] = '_';
+    }
+
+    return 0 == stat(path_buff, &st);
+}
+
+static void mount_configfs(void) {
+    struct stat st = {0};
+
+    if (0 == stat(BOOT_CONFIGFS_PATH "device-tree", &st))
+        return;
+
+    if (0 != mount("none", BOOT_CONFIGFS_PATH, "configfs", 0, NULL) && EBUSY != errno)
+        fprintf(stderr, "ERROR: Could not mount configfs to %s. errno: %d\n", BOOT_CONFIGFS_PATH, errno);
+}
+
+static void on_spawn_exit(uv_process_t *proc, int64_t exit_status, int term_signal) {
+    boot_proc_t *bproc = (boot_proc_t *)proc;
+
+    if (0 != exit_status || 0 != term_signal)
+        fprintf(stderr, "ERROR: '%s' exited with status %lld.\n", bproc->what, (long long)exit_status);
+
+    uv_close((uv_handle_t *)proc, on_handle_close);
+
+    spawn_pending--;
+    if (0 == spawn_pending && BOOT_PH_CORE == boot_phase)
+        start_devices();
+}
+
+static stdret_t spawn(const char *cmd, const char *arg) {
+    int ret = 0;
+    boot_proc_t *bproc = NULL;
+    uv_process_options_t options = {0};
+    char *args[] = {(char *)cmd, (char *)arg, NULL};
+
+    bproc = (boot_proc_t *)calloc(1, sizeof(boot_proc_t));
+    if (NULL == bproc) {
+        fprintf(stderr, "ERROR: Error allocating process for '%s %s'.\n", cmd, arg);
+        return STD_NOT_OK;
+    }
+    snprintf(bproc->what, sizeof(bproc->what), "%s %s", cmd, arg);
+
+    options.file    = cmd;
+    options.args    = args;
+    options.exit_cb = on_spawn_exit;
+
+    ret = uv_spawn(boot_loop, &bproc->proc, &options);
+    if (ret < 0) {
+        fprintf(stderr, "ERROR: Could not spawn '%s': %s\n", bproc->what, uv_strerror(ret));
+        uv_close((uv_handle_t *)&bproc->proc, on_handle_close);
+        return STD_NOT_OK;
+    }
+
+    spawn_pending++;
+    return STD_OK;
+}
+
+static void mark_ready(const u32 dev_idx) {
+    for (usize i = 0; i < boot_dev_cnt; i++) {
+        if (dev_idx == boot_dev_list[i].idx && !boot_dev_list[i].ready) {
+            boot_dev_list[i].ready = true;
+            boot_dev_ready_cnt++;
+            boot_ops->dev_ready(dev_idx);
+            break;
+        }
+    }
+
+    if (BOOT_PH_DEVICES == boot_phase && boot_dev_ready_cnt == boot_dev_cnt)
+        finish();
+}
+
+static void on_uevent(const uevent_t *uev) {
+    s32 dev_idx = -1;
+
+    if (NULL == uev->subsystem || 0 != str_compare(uev->subsystem, IIO_SUBSYSTEM))
+        return;
+
+    /* The probe order is not stable, the device is identified by its name instead */
+    if (0 == str_compare(uev->action, UEVENT_ACTION_ADD))
+        dev_idx = iiodisc_attach(uev->kobj_name);
+    else if (0 == str_compare(uev->action, UEVENT_ACTION_REMOVE))
+        (void)iiodisc_detach(uev->kobj_name);
+
+    if (dev_idx >= 0)
+        mark_ready((u32)dev_idx);
+}
+
+static void on_timeout(uv_timer_t *handle) {
+    (void)handle;
+
+    for (usize i = 0; i < boot_dev_cnt; i++) {
+        if (!boot_dev_list[i].ready)
+            fprintf(stderr, "ERROR: Device with index %u did not appear within %u ms.\n",
+                boot_dev_list[i].idx, BOOT_TIMEOUT_MS);
+    }
+
+    finish();
+}
+
+static void load_kmods(void) {
+    char path_buff[128] = {0};
+
+    for (usize i = 0; i < ARRAY_SIZE(kmod_list); i++) {
+        if (kmod_loaded(kmod_list[i]))
+            continue;
+
+        snprintf(path_buff, sizeof(path_buff), "%s%s.dtbo", BOOT_DTOVERLAY_PATH, kmod_list[i]);
+        (void)spawn(BOOT_CMD_DTOVERLAY, path_buff);
+
+        snprintf(path_buff, sizeof(path_buff), "%s%s.ko", BOOT_KMOD_PATH, kmod_list[i]);
+        (void)spawn(BOOT_CMD_INSMOD, path_buff);
+    }
+
+    for (usize i = 0; i < ARRAY_SIZE(mdt_kmod_list); i++) {
+        if (kmod_loaded(mdt_kmod_list[i]))
+            continue;
+
+        snprintf(path_buff, sizeof(path_buff), "%s%s.ko", BOOT_KMOD_PATH, mdt_kmod_list[i]);
+        (void)spawn(BOOT_CMD_INSMOD, path_buff);
+    }
+}
+
+static void start_devices(void) {
+    boot_phase = BOOT_PH_DEVICES;
+    boot_ops->core_ready();
+
+    /* Listen before loading anything, otherwise a fast probe could be missed */
+    if (STD_NOT_OK == uevent_addListener(boot_loop, on_uevent))
+        fprintf(stderr, "ERROR: Device hotplug is not monitored, only present devices are used.\n");
+
+    load_kmods();
+
+    for (usize i = 0; i < boot_dev_cnt; i++) {
+        if (iiodisc_isPresent(boot_dev_list[i].idx))
+            mark_ready(boot_dev_list[i].idx);
+    }
+
+    if (BOOT_PH_DEVICES != boot_phase)
+        return;
+
+    if (boot_dev_ready_cnt == boot_dev_cnt) {
+        finish();
+        return;
+    }
+
+    boot_timer = (uv_timer_t *)malloc(sizeof(uv_timer_t));
+    if (NULL == boot_timer) {
+        fprintf(stderr, "ERROR: Error allocating boot timer.\n");
+        finish();
+        return;
+    }
+    uv_timer_init(boot_loop, boot_timer);
+    uv_timer_start(boot_timer, on_timeout, BOOT_TIMEOUT_MS, 0);
+}
+
+static void finish(void) {
+    boot_phase = BOOT_PH_DONE;
+
+    if (NULL != boot_timer) {
+        uv_timer_stop(boot_timer);
+        uv_close((uv_handle_t *)boot_timer, on_handle_close);
+        boot_timer = NULL;
+    }
+
+    /* The runtime listener is added by done(), before this one is gone, so no uevent falls in between */
+    boot_ops->done(boot_dev_cnt - boot_dev_ready_cnt);
+    uevent_removeListener(on_uevent);
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+void boot_start(uv_loop_t *loop, const boot_ops_t *ops) {
+    boot_loop  = loop;
+    boot_ops   = ops;
+    boot_phase = BOOT_PH_CORE;
+
+    mount_configfs();
+
+    for (usize i = 0; i < ARRAY_SIZE(iio_kmod_list); i++) {
+        if (!kmod_loaded(iio_kmod_list[i]))
+            (void)spawn(BOOT_CMD_MODPROBE, iio_kmod_list[i]);
+    }
+
+    if (0 == spawn_pending)
+        start_devices();
+}
+
+void boot_expectDev(const u32 dev_idx) {
+    if (boot_dev_cnt >= BOOT_DEV_MAX) {
+        fprintf(stderr, "ERROR: Too many devices expected at boot.\n");
+        return;
+    }
+
+    boot_dev_list[boot_dev_cnt].idx = dev_idx;
+    boot_dev_list[boot_dev_cnt].ready = false;
+    boot_dev_cnt++;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
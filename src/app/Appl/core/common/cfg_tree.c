@@ -58,6 +58,14 @@ cfgtype_ht_t cfgtype_lut[] = {
     {"tim_to",      CFG_TIM_TO},
     {"tim_rep",     CFG_TIM_REP},
     {"global_ev_ref", CFG_EV_GLOBAL_REF},
+    {"stats",       CFG_STATS},
+    {"window",      CFG_STATS_WINDOW},
+    {"hop",         CFG_STATS_HOP},
+    {"raw",         CFG_STATS_RAW},
+    {"capture",     CFG_CAPTURE},
+    {"pre",         CFG_CAPTURE_PRE},
+    {"post",        CFG_CAPTURE_POST},
+    {"slope",       CFG_CAPTURE_SLOPE},
 };
 
 cfgreg_ht_t cfgreg_lut[] = {
@@ -80,6 +88,14 @@ cfgreg_ht_t cfgreg_lut[] = {
     {CFG_FIELD_NAME,    DEV_CONFIG_REG_NAME},
     {CFG_FIELD_VAL,     DEV_CONFIG_REG_VAL},
     {CFG_EV_GLOBAL_REF, DEV_CONFIG_REG_EV_G_REF},
+    {CFG_STATS,         DEV_CONFIG_REG_STATS},
+    {CFG_STATS_WINDOW,  DEV_CONFIG_REG_WINDOW},
+    {CFG_STATS_HOP,     DEV_CONFIG_REG_HOP},
+    {CFG_STATS_RAW,     DEV_CONFIG_REG_RAW},
+    {CFG_CAPTURE,       DEV_CONFIG_REG_CAPTURE},
+    {CFG_CAPTURE_PRE,   DEV_CONFIG_REG_PRE},
+    {CFG_CAPTURE_POST,  DEV_CONFIG_REG_POST},
+    {CFG_CAPTURE_SLOPE, DEV_CONFIG_REG_SLOPE},
 };
 
 static char cfg_buffer[128];
@@ -274,6 +290,35 @@ void cfgtree_free(node_t *root) {
     free(root);
 }
 
+node_t *cfgtree_load(const char *path) {
+    node_t *root        = NULL;
+    xml_line_t *xml_cfg = NULL;
+    xml_line_t *head    = NULL;
+    char line[128]      = {0};
+    usize file_pos      = 0;
+    int readline_stat   = 0;
+
+    xml_cfg = llist_init();
+    if (NULL == xml_cfg)
+        return NULL;
+
+    while ((readline_stat = get_line(path, &file_pos, line, sizeof(line))) >= 0)
+        llist_push(xml_cfg, line);
+
+    if (readline_stat == -2) {
+        llist_free(xml_cfg);
+        return NULL;
+    }
+
+    /* cfgtree_init() advances the given head, keep the original one to free the whole list */
+    head = xml_cfg;
+    cfgtree_dfaReset();
+    root = cfgtree_init(&xml_cfg);
+
+    llist_free(head);
+    return root;
+}
+
 int cfgtree_getCfgReg(const int conf) {
     int retval = 0;
 
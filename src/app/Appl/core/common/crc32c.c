@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+* crc32c.cpp                                                                                                          *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       CRC32C (Castagnoli) used for framing of the logs. The SSE4.2 crc32 instruction on x86-64 and the              *
+*       ARMv8 CRC32 extension on aarch64 are used when the CPU reports them, a table driven version otherwise.        *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       u32                 crc32c(u32 crc, const void *buff, usize size)                                             *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+# include <nmmintrin.h>
+#elif defined(__aarch64__)
+# include <sys/auxv.h>
+# include <asm/hwcap.h>
+#endif
+
+#include "crc32c.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define CRC32C_POLY  0x82F63B78U
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static u32 crc_table[256];
+static u32 (*crc_impl)(u32 crc, const u8 *buff, usize size);
+/* Frames are checked by the uv loop and the compression worker alike */
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u32 crc_sw(u32 crc, const u8 *buff, usize size) {
+    while (size--)
+        crc = crc_table[(crc ^ *buff++) & 0xFF] ^ (crc >> 8);
+
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+static u32 crc_hw(u32 crc, const u8 *buff, usize size) {
+    u64 crc64 = crc;
+    u64 word = 0;
+
+    for (; size >= sizeof(u64); size -= sizeof(u64), buff += sizeof(u64)) {
+        memcpy(&word, buff, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+
+    crc = (u32)crc64;
+    while (size--)
+        crc = _mm_crc32_u8(crc, *buff++);
+
+    return crc;
+}
+
+static bool hw_supported(void) {
+    return __builtin_cpu_supports("sse4.2");
+}
+#elif defined(__aarch64__)
+__attribute__((target("+crc")))
+static u32 crc_hw(u32 crc, const u8 *buff, usize size) {
+    u64 word = 0;
+
+    for (; size >= sizeof(u64); size -= sizeof(u64), buff += sizeof(u64)) {
+        memcpy(&word, buff, sizeof(word));
+        crc = __builtin_aarch64_crc32cx(crc, word);
+    }
+
+    while (size--)
+        crc = __builtin_aarch64_crc32cb(crc, *buff++);
+
+    return crc;
+}
+
+static bool hw_supported(void) {
+    return 0 != (getauxval(AT_HWCAP) & HWCAP_CRC32);
+}
+#else
+static bool hw_supported(void) {
+    return false;
+}
+#endif
+
+static void crc_init(void) {
+    u32 crc = 0;
+
+    for (u32 i = 0; i < 256; i++) {
+        crc = i;
+        for (int j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        crc_table[i] = crc;
+    }
+
+#if defined(__x86_64__) || defined(__aarch64__)
+    crc_impl = hw_supported() ? crc_hw : crc_sw;
+#else
+    (void)hw_supported;
+    crc_impl = crc_sw;
+#endif
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+u32 crc32c(u32 crc, const void *buff, usize size) {
+    pthread_once(&crc_once, crc_init);
+
+    return ~crc_impl(~crc, (const u8 *)buff, size);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
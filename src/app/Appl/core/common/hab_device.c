@@ -9,6 +9,9 @@
 *       habdev_t*           habdev_alloc(void)                                                                        *
 *       stdret_t            habdev_register(habdev_t *habdev, u32 idx)                                                *
 *       habdev_t*           habdev_get(const u32 idx)                                                                 *
+*       habdev_t*           habdev_getByName(const char *name)                                                        *
+*       dev_type_t          habdev_getCfgType(const u32 idx)                                                          *
+*       stdret_t            habdev_reload(habdev_t *habdev)                                                           *
 *       void                habdev_free(habdev_t *habdev)                                                             *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
@@ -28,6 +31,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <uv.h>
 
 #include "utils.h"
 #include "event.h"
@@ -36,19 +41,39 @@
 
 #include "llist.h"
 #include "cfg_tree.h"
+#include "iio_discovery.h"
 
 /**********************************************************************************************************************
  *  MACRO
  *********************************************************************************************************************/
-#define IIO_DEV_SYSFS_PATH   "/sys/bus/iio/devices/iio:device"
-#define IIO_BUFF_DEVFS_PATH  "/dev/iio:device"
 #define IIO_DEV_NAME_SUBPATH "/name"
 #define IIO_DEV_SCAN_EL_SUBPATH "scan_elements/"
+#define IIO_DEV_TS_CLOCK        "current_timestamp_clock"
+#define IIO_TS_CLOCK_MONOTONIC  "monotonic\n"
+#define IIO_BUFF_TRIG_SUBPATH   "trigger/current_trigger"
+#define IIO_BUFF_LEN_SUBPATH    "buffer/length"
+#define IIO_BUFF_EN_SUBPATH     "buffer/enable"
+
+#define HABDEV_ATTR_MAX 32
 
 /**********************************************************************************************************************
  * LOCAL TYPEDEFS DECLARATION
  *********************************************************************************************************************/
- 
+/* Single sysfs attribute requested by the device configuration */
+typedef struct {
+    int cfg;
+    char name[64];
+    char val[64];
+} habdev_attr_t;
+
+/* Flat view of the runtime-changeable part of a configuration tree */
+typedef struct {
+    int tim_rep;
+    iiostats_cfg_t stats;
+    iiocap_cfg_t capture;
+    usize attr_num;
+    habdev_attr_t attr[HABDEV_ATTR_MAX];
+} habdev_cfg_t;
 
 /**********************************************************************************************************************
  * GLOBAL VARIABLES DECLARATION
@@ -84,6 +109,52 @@ static stdret_t add_channel(char **habdev_ch, const char *ch) {
     return STD_OK;
 }
 
+static bool read_double(const char *dev_path, const char *name, const char *suffix, double *val) {
+    char path_buff[128] = {0};
+    char val_buff[32] = {0};
+
+    /* Scale and offset are optional, a missing one is probed without the read error */
+    snprintf(path_buff, sizeof(path_buff), "%s%s%s", dev_path, name, suffix);
+    if (0 != access(path_buff, R_OK) ||
+        STD_NOT_OK == read_file(path_buff, val_buff, sizeof(val_buff) - 1, MOD_R) || 0 == val_buff[0])
+        return false;
+
+    *val = strtod(val_buff, NULL);
+    return true;
+}
+
+/**
+ * Scale and offset of a scan element, e.g. in_accel_x_en. A channel may have its own attribute (in_accel_x_scale)
+ * or share the one of its type (in_accel_scale). Missing attributes leave the value as it is.
+ */
+static void get_conversion(const char *dev_path, const char *chan, iioconv_chan_t *conv) {
+    char name[64] = {0};
+    char type[64] = {0};
+    double scale = 1.0, offset = 0.0;
+    bool scaled = false;
+    usize len = 0;
+    const char *pos = strchr(chan, '_');
+
+    snprintf(name, sizeof(name), "%s", chan);
+    len = strlen(name);
+    if (len > 3 && 0 == strcmp(name + len - 3, "_en"))
+        name[len - 3] = '\0';
+
+    /* The type ends at the first index, modifier or differential separator */
+    len = (NULL == pos) ? 0 : (usize)(pos - chan) + 1U;
+    while (0 != chan[len] && '_' != chan[len] && '-' != chan[len] && (chan[len] < '0' || chan[len] > '9'))
+        len++;
+    snprintf(type, min(sizeof(type), len + 1U), "%s", chan);
+
+    scaled = read_double(dev_path, name, IIOCONV_SCALE_SUFFIX, &scale) ||
+             read_double(dev_path, type, IIOCONV_SCALE_SUFFIX, &scale);
+    if (!read_double(dev_path, name, IIOCONV_OFFSET_SUFFIX, &offset))
+        (void)read_double(dev_path, type, IIOCONV_OFFSET_SUFFIX, &offset);
+
+    iioconv_setScale(conv, scale, offset);
+    conv->scaled = scaled;
+}
+
 static stdret_t get_storagebits(habdev_t *habdev, const char *chan) {
     stdret_t retval = STD_NOT_OK;
     int bits = 0;
@@ -94,7 +165,9 @@ static stdret_t get_storagebits(habdev_t *habdev, const char *chan) {
     char ch_format[32] = {0};
     char dev_path[64] = {0};
 
-    habdev_getDevPath(habdev, dev_path, sizeof(dev_path));
+    /* An empty prefix would read the working directory */
+    if (STD_NOT_OK == habdev_getDevPath(habdev, dev_path, sizeof(dev_path)))
+        return STD_NOT_OK;
     snprintf(cfg_path, sizeof(cfg_path), "%s%s%s", dev_path, IIO_DEV_SCAN_EL_SUBPATH, chan);
     strcpy(cfg_path + (strlen(cfg_path) - 2), "type");
 
@@ -109,74 +182,24 @@ static stdret_t get_storagebits(habdev_t *habdev, const char *chan) {
     for (; ch_format[cnt] != '>'; cnt++)
         bits = bits * 10 + (ch_format[cnt] - '0');
     
-    /**
-     * UGLY FIX
-     * For now the Timestamp is not analyzed at all.
-     * To make it possibly probably a config param is needed.
-    */
-    if (0 != str_compare(chan, "in_timestamp_en"))
-        habdev->df.storagebits[habdev->df.chan_num++] = bits;
-
-    if (0 == str_compare(chan, "in_timestamp_en"))
+    /* The conversion plan is filled with the format, scans are converted without touching sysfs */
+    if (STD_OK == iioconv_parseType(&habdev->conv.chan[habdev->df.chan_num], ch_format))
+        get_conversion(dev_path, chan, &habdev->conv.chan[habdev->df.chan_num]);
+    habdev->df.storagebits[habdev->df.chan_num++] = bits;
+    habdev->conv.chan_num = habdev->df.chan_num;
+
+    /* Kernel timestamps are taken from the clock of habtime_nowNs(), so the scans line up with every other log */
+    if (0 == str_compare(chan, "in_timestamp_en")) {
         habdev->df.ts_en = true;
+        snprintf(cfg_path, sizeof(cfg_path), "%s%s", dev_path, IIO_DEV_TS_CLOCK);
+        if (STD_NOT_OK == write_file(cfg_path, IIO_TS_CLOCK_MONOTONIC, strlen(IIO_TS_CLOCK_MONOTONIC), MOD_W))
+            fprintf(stderr, "ERROR: Timestamps of %s are not monotonic.\n", habdev->path.dev_name);
+    }
 
     return STD_OK;
 }
 
 
-static stdret_t write_config(const habdev_t *habdev, node_t *node, int cfg) {
-    stdret_t retval      = STD_OK;
-    const char *cfg_path = NULL;
-    char path_buff[256]  = {0};
-    char dev_path[64]    = {0};
-    int child_cnt        = 0;
-
-    cfg |= cfgtree_getCfgReg(node->type);
-    habdev_getDevPath(habdev, dev_path, sizeof(dev_path));
-
-    switch (cfg & 0xFFFF) {
-    case CFGTREE_BUFF_CONFIG:
-        snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, "trigger/current_trigger");
-        retval = write_file(path_buff, habdev->trig->name, sizeof(habdev->trig->name), MOD_W);
-        break;
-    case CFGTREE_BUFF_CHAN_NAME_CONFIG:
-        snprintf(config_buff, sizeof(config_buff), "%s%s", IIO_DEV_SCAN_EL_SUBPATH, node->val);
-        break;
-    case CFGTREE_BUFF_CHAN_VAL_CONFIG:
-        snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, config_buff);
-        retval = write_file(path_buff, node->val, sizeof(node->val), MOD_W);
-        memset(config_buff, 0, sizeof(config_buff));
-        break;
-    case CFGTREE_BUFF_LEN_CONFIG:
-        snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, "buffer/length");
-        retval = write_file(path_buff, node->val, sizeof(node->val), MOD_W);
-        break;
-    case CFGTREE_BUFF_ENABLE:
-        snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, "buffer/enable");
-        retval = write_file(path_buff, node->val, sizeof(node->val), MOD_W);
-        break;
-    case CFGTREE_CHAN_NAME_CONFIG:
-        snprintf(config_buff, sizeof(config_buff), "%s", node->val);
-        break;
-    case CFGTREE_CHAN_VAL_CONFIG:
-        snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, config_buff);
-        retval = write_file(path_buff, node->val, sizeof(node->val), MOD_W);
-        memset(config_buff, 0, sizeof(config_buff));
-        break;
-    default:
-        break;
-    }
-
-    if (STD_NOT_OK == retval)
-        return STD_NOT_OK;
-
-    while (child_cnt < node->child_num) {
-        retval = write_config(habdev, node->child[child_cnt++], cfg);
-    }
-
-    return retval;
-}
-
 static stdret_t save_config(habdev_t *habdev, node_t *node, int cfg) {
     stdret_t retval = STD_OK;
 
@@ -188,7 +211,8 @@ static stdret_t save_config(habdev_t *habdev, node_t *node, int cfg) {
     /* A device type shall not be considered (0xFFFF mask) */
     switch (cfg & 0xFFFF) {
     case CFGTREE_BUFF_CONFIG:
-        snprintf(buff, sizeof(buff), "%s%d", IIO_BUFF_DEVFS_PATH, habdev->index);
+        if (NULL != iiodisc_getDevfsPath(habdev->index))
+            snprintf(buff, sizeof(buff), "%s", iiodisc_getDevfsPath(habdev->index));
         retval = add_channel(&habdev->path.buffer[habdev->buffer_num++], buff);
         break;
     case CFGTREE_CHAN_NAME_CONFIG:
@@ -234,6 +258,209 @@ static stdret_t save_config(habdev_t *habdev, node_t *node, int cfg) {
     return STD_OK;
 }
 
+static void push_attr(habdev_cfg_t *dev_cfg, const int cfg, const char *name, const char *val) {
+    habdev_attr_t *attr = NULL;
+
+    if (dev_cfg->attr_num >= HABDEV_ATTR_MAX) {
+        fprintf(stderr, "ERROR: Too many attributes in configuration. Skipping: %s\n", name);
+        return;
+    }
+
+    attr = &dev_cfg->attr[dev_cfg->attr_num++];
+    attr->cfg = cfg;
+    snprintf(attr->name, sizeof(attr->name), "%s", name);
+    snprintf(attr->val, sizeof(attr->val), "%s", val);
+}
+
+static void collect_config(const habdev_t *habdev, habdev_cfg_t *dev_cfg, node_t *node, int cfg) {
+    int child_cnt = 0;
+
+    cfg |= cfgtree_getCfgReg(node->type);
+
+    switch (cfg & 0xFFFF) {
+    case CFGTREE_BUFF_CONFIG:
+        if (NULL != habdev->trig)
+            push_attr(dev_cfg, cfg & 0xFFFF, IIO_BUFF_TRIG_SUBPATH, habdev->trig->name);
+        break;
+    case CFGTREE_BUFF_CHAN_NAME_CONFIG:
+    case CFGTREE_CHAN_NAME_CONFIG:
+        snprintf(config_buff, sizeof(config_buff), "%s", node->val);
+        break;
+    case CFGTREE_BUFF_CHAN_VAL_CONFIG:
+    case CFGTREE_CHAN_VAL_CONFIG:
+        push_attr(dev_cfg, cfg & 0xFFFF, config_buff, node->val);
+        memset(config_buff, 0, sizeof(config_buff));
+        break;
+    case CFGTREE_BUFF_LEN_CONFIG:
+        push_attr(dev_cfg, cfg & 0xFFFF, IIO_BUFF_LEN_SUBPATH, node->val);
+        break;
+    case CFGTREE_BUFF_ENABLE:
+        push_attr(dev_cfg, cfg & 0xFFFF, IIO_BUFF_EN_SUBPATH, node->val);
+        break;
+    case CFGTREE_EVENT_TIM_REP_CONFIG:
+        dev_cfg->tim_rep = atoi(node->val);
+        break;
+    case CFGTREE_STATS_WINDOW_CONFIG:
+        dev_cfg->stats.window = (u16)atoi(node->val);
+        break;
+    case CFGTREE_STATS_HOP_CONFIG:
+        dev_cfg->stats.hop = (u16)atoi(node->val);
+        break;
+    case CFGTREE_STATS_RAW_CONFIG:
+        dev_cfg->stats.raw = (0 != atoi(node->val));
+        break;
+    case CFGTREE_CAPTURE_PRE_CONFIG:
+        dev_cfg->capture.pre_ms = (u32)atoi(node->val);
+        break;
+    case CFGTREE_CAPTURE_POST_CONFIG:
+        dev_cfg->capture.post_ms = (u32)atoi(node->val);
+        break;
+    case CFGTREE_CAPTURE_SLOPE_CONFIG:
+        dev_cfg->capture.slope = (s32)atoi(node->val);
+        break;
+    default:
+        break;
+    }
+
+    while (child_cnt < node->child_num)
+        collect_config(habdev, dev_cfg, node->child[child_cnt++], cfg);
+}
+
+static const habdev_attr_t *find_attr(const habdev_cfg_t *dev_cfg, const int cfg, const char *name) {
+    const habdev_attr_t *retval = NULL;
+
+    for (usize i = 0; i < dev_cfg->attr_num; i++) {
+        if (cfg == dev_cfg->attr[i].cfg && 0 == str_compare(name, dev_cfg->attr[i].name)) {
+            retval = &dev_cfg->attr[i];
+            break;
+        }
+    }
+
+    return retval;
+}
+
+static stdret_t get_attr_path(const habdev_t *habdev, const habdev_attr_t *attr, char *buff, usize size) {
+    char dev_path[64] = {0};
+
+    if (STD_NOT_OK == habdev_getDevPath(habdev, dev_path, sizeof(dev_path)))
+        return STD_NOT_OK;
+
+    if (CFGTREE_BUFF_CHAN_VAL_CONFIG == attr->cfg)
+        snprintf(buff, size, "%s%s%s", dev_path, IIO_DEV_SCAN_EL_SUBPATH, attr->name);
+    else
+        snprintf(buff, size, "%s%s", dev_path, attr->name);
+
+    return STD_OK;
+}
+
+/**
+ * Compare the requested value with the one currently exposed by the driver.
+ * Reading an attribute is cheap compared to a write, which may end up in bus traffic or buffer reallocation.
+ */
+static bool attr_differs(const habdev_t *habdev, const habdev_attr_t *attr) {
+    char path_buff[256] = {0};
+    char curr_val[64]   = {0};
+
+    /* A device off the bus differs, the write that follows reports it */
+    if (STD_NOT_OK == get_attr_path(habdev, attr, path_buff, sizeof(path_buff)) ||
+        STD_NOT_OK == read_file(path_buff, curr_val, sizeof(curr_val) - 1, MOD_R))
+        return true;
+    CROP_NEWLINE(curr_val, strlen(curr_val));
+
+    return 0 != str_compare(curr_val, attr->val);
+}
+
+static stdret_t write_attr(const habdev_t *habdev, const habdev_attr_t *attr) {
+    char path_buff[256] = {0};
+
+    if (STD_NOT_OK == get_attr_path(habdev, attr, path_buff, sizeof(path_buff))) {
+        fprintf(stderr, "ERROR: %s is not on the bus, %s is not written.\n", habdev->path.dev_name, attr->name);
+        return STD_NOT_OK;
+    }
+
+    return write_file(path_buff, attr->val, strlen(attr->val), MOD_W);
+}
+
+/**
+ * Re-read the buffer data format for the currently enabled scan elements.
+ * Channel order is kept the same as in the configuration file.
+ */
+static stdret_t update_data_format(habdev_t *habdev, const habdev_cfg_t *dev_cfg) {
+    stdret_t retval = STD_OK;
+
+    memset(&habdev->df, 0, sizeof(habdev->df));
+    memset(&habdev->conv, 0, sizeof(habdev->conv));
+
+    for (usize i = 0; i < dev_cfg->attr_num && STD_OK == retval; i++) {
+        if (CFGTREE_BUFF_CHAN_VAL_CONFIG == dev_cfg->attr[i].cfg && 0 != atoi(dev_cfg->attr[i].val))
+            retval = get_storagebits(habdev, dev_cfg->attr[i].name);
+    }
+
+    return retval;
+}
+
+/**
+ * Bring the device attributes to the requested configuration writing only the values that differ.
+ * The buffer is toggled only when one of its parameters (trigger, scan elements, length) actually changes,
+ * as those can only be written while the buffer is disabled.
+ */
+static stdret_t apply_config(const habdev_t *habdev, const habdev_cfg_t *dev_cfg, bool *buff_changed) {
+    stdret_t retval = STD_OK;
+    const habdev_attr_t *attr = NULL;
+    const habdev_attr_t *buff_en = find_attr(dev_cfg, CFGTREE_BUFF_ENABLE, IIO_BUFF_EN_SUBPATH);
+    habdev_attr_t buff_off = {.cfg = CFGTREE_BUFF_ENABLE, .name = IIO_BUFF_EN_SUBPATH, .val = "0"};
+    bool dirty[HABDEV_ATTR_MAX] = {0};
+
+    *buff_changed = false;
+
+    for (usize i = 0; i < dev_cfg->attr_num; i++) {
+        attr = &dev_cfg->attr[i];
+        if (CFGTREE_BUFF_ENABLE == attr->cfg || !attr_differs(habdev, attr))
+            continue;
+
+        if (CFGTREE_CHAN_VAL_CONFIG == attr->cfg) {
+            retval |= write_attr(habdev, attr);
+        } else {
+            dirty[i] = true;
+            *buff_changed = true;
+        }
+    }
+
+    if (*buff_changed) {
+        if (attr_differs(habdev, &buff_off))
+            retval |= write_attr(habdev, &buff_off);
+
+        for (usize i = 0; i < dev_cfg->attr_num; i++) {
+            if (dirty[i])
+                retval |= write_attr(habdev, &dev_cfg->attr[i]);
+        }
+    }
+
+    if (NULL != buff_en && attr_differs(habdev, buff_en))
+        retval |= write_attr(habdev, buff_en);
+
+    return retval;
+}
+
+static void update_timer(habdev_t *habdev, const int tim_rep) {
+    uv_timer_t *timer = NULL;
+
+    if (NULL == habdev->event || tim_rep == habdev->event->hcfg.tim_ev.tim_rep)
+        return;
+
+    habdev->event->hcfg.tim_ev.tim_rep = tim_rep;
+
+    /* Only devices from the timer event table have their handle started by hab_run() */
+    if (event_getEvIdx(habdev->index) < 0)
+        return;
+
+    timer = (uv_timer_t *)habdev->event->handle;
+    uv_timer_set_repeat(timer, tim_rep);
+    if (tim_rep > 0)
+        (void)uv_timer_again(timer);
+    else
+        (void)uv_timer_stop(timer);
+}
 
 /**********************************************************************************************************************
  * GLOBAL FUNCTION DEFINITION
@@ -248,17 +475,24 @@ void habdev_postinit(void) {
     cfgtree_freeDfa();
 }
 
-void habdev_getDevPath(const habdev_t *habdev, char *buff, usize size) {
+stdret_t habdev_getDevPath(const habdev_t *habdev, char *buff, usize size) {
+    stdret_t retval = STD_NOT_OK;
+
     memset(buff, 0, size);
 
     switch(habdev->dev_type) {
     case DEV_IIO:
     case DEV_IIO_BUFF:
-        snprintf(buff, size, "%s%d/", IIO_DEV_SYSFS_PATH, habdev->index);
+        if (NULL != iiodisc_getSysfsPath(habdev->index)) {
+            snprintf(buff, size, "%s", iiodisc_getSysfsPath(habdev->index));
+            retval = STD_OK;
+        }
         break;
     default:
         break;
     }
+
+    return retval;
 }
 
 void habdev_getLogPath(const habdev_t *habdev, char *buff, usize size) {
@@ -275,7 +509,7 @@ habdev_t *habdev_alloc(void) {
         return NULL;
     }
 
-    memset(habdev, 0, sizeof(habdev));
+    memset(habdev, 0, sizeof(habdev_t));
     habdev->id = habdev_count;
     habdev_list[habdev_count++] = habdev;
 
@@ -283,26 +517,19 @@ habdev_t *habdev_alloc(void) {
 }
 
 stdret_t habdev_register(habdev_t *habdev, u32 idx) {
-    stdret_t retval = STD_NOT_OK;
-    char path_buff[64]  = {0};
-    char line[128]      = {0};
-    usize file_pos      = 0;
-    int readline_stat   = 0;
+    stdret_t retval       = STD_NOT_OK;
+    habdev_cfg_t *dev_cfg = NULL;
+    bool buff_changed     = false;
+    char path_buff[64]    = {0};
 
     habdev->index = idx;
     snprintf(habdev->path.dev_name, sizeof(habdev->path.dev_name), "%s", dev_names[habdev->index]);
 
     /* Parse the device configuration and save it */
-    xml_line_t *xml_cfg = llist_init();
     snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DEV_CFG_PATH, dev_names[habdev->index]);
-    for (int i = 0; (readline_stat = get_line(path_buff, &file_pos, line, sizeof(line))) >= 0; i++)
-        llist_push(xml_cfg, line);
-
-    if (readline_stat == -2)
+    habdev->node = cfgtree_load(path_buff);
+    if (NULL == habdev->node)
         return STD_NOT_OK;
-    
-    cfgtree_dfaReset();
-    habdev->node = cfgtree_init(&xml_cfg);
     /* First entrance in the config xml file is the device config */
     habdev->dev_type = (dev_type_t)habdev->node->type;
     if (habdev->dev_type == DEV_IIO_BUFF)
@@ -314,22 +541,97 @@ stdret_t habdev_register(habdev_t *habdev, u32 idx) {
         return STD_NOT_OK;
     }
 
-    retval = write_config(habdev, habdev->node, 0);
+    dev_cfg = (habdev_cfg_t *)calloc(1, sizeof(habdev_cfg_t));
+    if (NULL == dev_cfg) {
+        fprintf(stderr, "ERROR: Error allocating configuration for device: %s\n", habdev->path.dev_name);
+        return STD_NOT_OK;
+    }
+
+    collect_config(habdev, dev_cfg, habdev->node, 0);
+    habdev->stats = dev_cfg->stats;
+    habdev->capture = dev_cfg->capture;
+    retval = apply_config(habdev, dev_cfg, &buff_changed);
+    /* The configuration may set the range, the scales are only final after it is written */
+    if (STD_OK == retval && DEV_IIO_BUFF == habdev->dev_type)
+        retval = update_data_format(habdev, dev_cfg);
+    free(dev_cfg);
+
     if (STD_NOT_OK == retval) {
         fprintf(stderr, "ERROR: Error writing configuration for device: %s\n", habdev->path.dev_name);
         return STD_NOT_OK;
     }
 
-    llist_free(xml_cfg);
+    return retval;
+}
+
+stdret_t habdev_reload(habdev_t *habdev) {
+    stdret_t retval       = STD_NOT_OK;
+    node_t *node          = NULL;
+    habdev_cfg_t *dev_cfg = NULL;
+    bool buff_changed     = false;
+    char path_buff[64]    = {0};
+
+    snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DEV_CFG_PATH, habdev->path.dev_name);
+
+    cfgtree_initDfa();
+    node = cfgtree_load(path_buff);
+    cfgtree_freeDfa();
 
+    /* Editors may trigger the watch on a half-written file. Keep the old setup until the file is complete */
+    if (NULL == node || node->type != habdev->node->type) {
+        fprintf(stderr, "ERROR: Configuration of %s is incomplete, reload skipped.\n", habdev->path.dev_name);
+        if (NULL != node)
+            cfgtree_free(node);
+        return STD_NOT_OK;
+    }
+
+    dev_cfg = (habdev_cfg_t *)calloc(1, sizeof(habdev_cfg_t));
+    if (NULL == dev_cfg) {
+        fprintf(stderr, "ERROR: Error allocating configuration for device: %s\n", habdev->path.dev_name);
+        cfgtree_free(node);
+        return STD_NOT_OK;
+    }
+
+    collect_config(habdev, dev_cfg, node, 0);
+    habdev->stats = dev_cfg->stats;
+    habdev->capture = dev_cfg->capture;
+
+    retval = apply_config(habdev, dev_cfg, &buff_changed);
+    /* Any channel attribute may change a scale, the plan is read again with the format */
+    if (DEV_IIO_BUFF == habdev->dev_type)
+        retval |= update_data_format(habdev, dev_cfg);
+    update_timer(habdev, dev_cfg->tim_rep);
+
+    if (STD_NOT_OK == retval)
+        fprintf(stderr, "ERROR: Error applying reloaded configuration for device: %s\n", habdev->path.dev_name);
+
+    cfgtree_free(habdev->node);
+    habdev->node = node;
+
+    free(dev_cfg);
     return retval;
 }
 
 
+dev_type_t habdev_getCfgType(const u32 idx) {
+    dev_type_t dev_type = DEV_UNKNOWN;
+    node_t *node        = NULL;
+    char path_buff[64]  = {0};
+
+    snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DEV_CFG_PATH, dev_names[idx]);
+    node = cfgtree_load(path_buff);
+    if (NULL != node) {
+        dev_type = (dev_type_t)node->type;
+        cfgtree_free(node);
+    }
+
+    return dev_type;
+}
+
 habdev_t *habdev_get(const u32 idx) {
     habdev_t *habdev = NULL;
 
-    for (usize i = 0; i < ARRAY_SIZE(habdev_list); i++) {
+    for (usize i = 0; i < habdev_count; i++) {
         if (idx == habdev_list[i]->index) {
             habdev = habdev_list[i];
             break;
@@ -338,6 +640,18 @@ habdev_t *habdev_get(const u32 idx) {
     return habdev;
 }
 
+habdev_t *habdev_getByName(const char *name) {
+    habdev_t *habdev = NULL;
+
+    for (usize i = 0; i < habdev_count; i++) {
+        if (0 == str_compare(name, habdev_list[i]->path.dev_name)) {
+            habdev = habdev_list[i];
+            break;
+        }
+    }
+    return habdev;
+}
+
 void habdev_free(habdev_t *habdev) {
     free(habdev);
 }
@@ -35,7 +35,7 @@
 xml_line_t *llist_init(void) {
     xml_line_t *head = NULL;
 
-    head = (xml_line_t *) malloc(sizeof(xml_line_t));
+    head = (xml_line_t *) calloc(1, sizeof(xml_line_t));
     if (NULL == head)
         fprintf(stderr, "ERROR: Error allocation list head.\n");
 
@@ -55,7 +55,7 @@ void llist_push(xml_line_t *head, char *val) {
     while (head->next != NULL)
         head = head->next;
 
-    new_node = (xml_line_t *) malloc(sizeof(xml_line_t));
+    new_node = (xml_line_t *) calloc(1, sizeof(xml_line_t));
     new_node->next = NULL;
 
     while(val[space_cnt] == ' ')
@@ -157,6 +157,26 @@ stdret_t hexdump(const char *filepath, const char *buff, usize size, const char
     return ret;
 }
 
+usize hexdump_str(char *dst, usize size, const char *buff, usize rec_num, const char *append) {
+    usize len = 0;
+
+    for (usize i = 0; i < rec_num && len < size; i++) {
+        for (usize j = 0; j < HEXDUMP_RECORD_LEN && len < size; j++) {
+            len += snprintf(dst + len, size - len, "%02x", (u8)buff[j + i * HEXDUMP_RECORD_LEN]);
+            if (j % 2 != 0 && len < size)
+                len += snprintf(dst + len, size - len, " ");
+        }
+        if (len >= size)
+            break;
+        if (NULL != append)
+            len += snprintf(dst + len, size - len, "| %s\n", append);
+        else
+            len += snprintf(dst + len, size - len, "\n");
+    }
+
+    return min(len, size);
+}
+
 stdret_t read_file(const char *filepath, char *buff, usize size, file_mode_t fmod) {
     stdret_t ret = STD_NOT_OK;
     FILE *filp = NULL;
@@ -169,9 +189,9 @@ stdret_t read_file(const char *filepath, char *buff, usize size, file_mode_t fmo
         printf("errno %d\n", errno);
     } else {
         fread(buff, sizeof(char), size, filp);
+        fclose(filp);
         ret = STD_OK;
     }
-    fclose(filp);
 
     return ret;
 }
@@ -203,8 +223,8 @@ s64 merge_bytes(const u8 *bytes, const u8 bits) {
         ret |= (s64)bytes[i] << (i * 8);
     
     /* Handle TS differently? */
-    if (ret & (1 << (bits - 1)))
-        ret = -((1 << bits) - ret);
+    if (bits < 64 && (ret & (1LL << (bits - 1))))
+        ret -= (1LL << bits);
     
     return ret;
 }
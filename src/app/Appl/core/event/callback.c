@@ -10,8 +10,9 @@
 *       CALLBACK            ADS1115_49_CALLBACK(uv_timer_t *handle)                                                   *
 *       CALLBACK            MPRLS0025_CALLBACK(uv_timer_t *handle)                                                    *
 *       CALLBACK            MLX90614_CALLBACK(uv_timer_t *handle)                                                     *
-*       CALLBACK            ICM20948_CALLBACK(uv_timer_t *handle)                                                       *
+*       CALLBACK            ICM20948_CALLBACK(uv_timer_t *handle)                                                     *
 *       CALLBACK            SHT4X_CALLBACK(uv_timer_t *handle)                                                        *
+*       CALLBACK            cfg_reload_callback(uv_fs_event_t *handle, ...)                                           *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -78,9 +79,7 @@ CALLBACK MPRLS0025_CALLBACK(uv_timer_t *handle) {
 #ifdef ICM20948_CALLBACK
 CALLBACK ICM20948_CALLBACK(uv_timer_t *handle) {
     habdev_t *icm20x_dev = (habdev_t *)uv_handle_get_data((uv_handle_t *)handle);
-    printf("%s\n", icm20x_dev->path.dev_name);
-    // ffdet_process_frame(icm20x_dev);
-
+    ffdet_process_frame(icm20x_dev);
 }
 #endif
 
@@ -129,6 +128,25 @@ CALLBACK IMX477_02_CALLBACK(uv_timer_t *handle) {
 }
 #endif
 
+CALLBACK cfg_reload_callback(uv_fs_event_t *handle, const char *filename, int events, int status) {
+    habdev_t *habdev = NULL;
+
+    (void)handle;
+    (void)events;
+
+    if (status < 0 || NULL == filename) {
+        fprintf(stderr, "ERROR: Configuration watch failed: %s\n", uv_strerror(status));
+        return;
+    }
+
+    /* Only the changed device is touched, every other device keeps running untouched */
+    habdev = habdev_getByName(filename);
+    if (NULL != habdev && NULL != habdev->node) {
+        printf("INFO: Reloading configuration for %s\n", habdev->path.dev_name);
+        (void)habdev_reload(habdev);
+    }
+}
+
 #ifdef EV_MAIN_CALLBACK
 CALLBACK EV_MAIN_CALLBACK(uv_timer_t *handle) {
     ev_glob_t *ev_main = (ev_glob_t *)uv_handle_get_data((uv_handle_t *)handle);
@@ -5,6 +5,7 @@
  *       APIs for controlling application events (i.e. timer, filesystem, socket connection etc.)                      *
  * PUBLIC FUNCTIONS :                                                                                                  *
  *       ev_t*               event_alloc(void)                                                                         *
+ *       stdret_t            event_registerFsEv(ev_t *ev, const char *path, fs_cb)                                     *
  *                                                                                                                     *
  * AUTHOR :                                                                                                            *
  *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -41,6 +42,11 @@ typedef struct {
     int cb_idx;
 } dev_cb_ht_t;
 
+typedef struct {
+    ev_sub_cb_t cb;
+    void *ctx;
+} ev_sub_t;
+
 /***********************************************************************************************************************
  * GLOBAL VARIABLES DECLARATION
  **********************************************************************************************************************/
@@ -54,6 +60,9 @@ extern CALLBACK (*ev_global_tim_cb[64])(uv_timer_t *handle);
 static dev_cb_ht_t dev_cb_ht[16];
 static usize dev_cb_cnt;
 
+static ev_sub_t ev_subs[EV_TOPIC_NUM][EV_SUB_MAX];
+static usize ev_sub_cnt[EV_TOPIC_NUM];
+
 /**********************************************************************************************************************
  * LOCAL FUNCTION DECLARATION
  *********************************************************************************************************************/
@@ -117,7 +126,8 @@ ev_t *event_alloc(void) {
     }
     memset(event, 0, sizeof(ev_t));
 
-    handle = (uv_handle_t *)malloc(sizeof(uv_handle_t) + sizeof(habdev_t));
+    /* The same event may back a timer or a filesystem watch, so reserve room for any handle type */
+    handle = (uv_handle_t *)malloc(sizeof(union uv_any_handle));
     if (NULL == handle) {
         fprintf(stderr, "ERROR: Error when allocating event handle.\n");
         return NULL;
@@ -128,6 +138,20 @@ ev_t *event_alloc(void) {
     return event;
 }
 
+stdret_t event_registerFsEv(ev_t *ev, const char *path,
+                            void (*fs_cb)(uv_fs_event_t *handle, const char *filename, int events, int status)) {
+    ev->hcfg.fs_path = strdup(path);
+    if (NULL == ev->hcfg.fs_path) {
+        fprintf(stderr, "ERROR: Error allocating watched path: %s\n", path);
+        return STD_NOT_OK;
+    }
+
+    ev->fs_cb = fs_cb;
+    uv_handle_set_data(ev->handle, ev);
+
+    return STD_OK;
+}
+
 ev_glob_t *event_allocGlobalEv(void) {
     ev_glob_t *ev_glob = NULL;
     ev_t *ev = NULL;
@@ -232,6 +256,27 @@ usize event_getGlobalNum(void) {
     return ARRAY_SIZE(ev_glob_name_list);
 }
 
+stdret_t event_subscribe(const ev_topic_t topic, ev_sub_cb_t cb, void *ctx) {
+    if (topic >= EV_TOPIC_NUM || NULL == cb || EV_SUB_MAX == ev_sub_cnt[topic]) {
+        fprintf(stderr, "ERROR: Could not subscribe to event topic %d.\n", topic);
+        return STD_NOT_OK;
+    }
+
+    ev_subs[topic][ev_sub_cnt[topic]].cb = cb;
+    ev_subs[topic][ev_sub_cnt[topic]++].ctx = ctx;
+
+    return STD_OK;
+}
+
+/* Subscribers run synchronously in the order they subscribed, they must not block the loop */
+void event_publish(const ev_msg_t *msg) {
+    if (msg->topic >= EV_TOPIC_NUM)
+        return;
+
+    for (usize i = 0; i < ev_sub_cnt[msg->topic]; i++)
+        ev_subs[msg->topic][i].cb(msg, ev_subs[msg->topic][i].ctx);
+}
+
 /***********************************************************************************************************************
  * END OF FILE
  **********************************************************************************************************************/
@@ -9,6 +9,7 @@
 *       habtrig_t*          habtrig_alloc(void);                                                                      *
 *       void                habtrig_free(habtrig_t *trig);                                                            *
 *       stdret_t            habtrig_register(habtrig_t *trig, u32 period_ms);                                         *
+*       int                 hab_boot(void);                                                                           *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -27,12 +28,22 @@
 #include <uv.h>
 
 #include "hab.h"
+#include "boot.h"
 #include "utils.h"
 #include "event.h"
 #include "callback.h"
 #include "hab_trig.h"
 #include "hab_device.h"
 #include "iio_buffer_ops.h"
+#include "cfg_tree.h"
+#include "uevent.h"
+#include "iio_discovery.h"
+#include "storage_budget.h"
+#include "storage_shaper.h"
+#include "hab_time.h"
+#include "telemetry.h"
+#include "ff_detector.h"
+#include "alt_fusion.h"
 
 /* UGLY QUICK FIX. REWORK */
 #include <string.h>
@@ -40,6 +51,9 @@
 /**********************************************************************************************************************
  *  PREPROCESSOR DEFINITIONS
  *********************************************************************************************************************/
+#define IIO_SUBSYSTEM "iio"
+#define FLIGHT_PHASE_LOG "/flight_phase"
+#define ALTITUDE_LOG     "/altitude"
 
 
 /**********************************************************************************************************************
@@ -51,6 +65,8 @@ const u32 trig_val_list[] = TRIG_PERIOD_SET;
 uv_loop_t *loop;
 uv_work_t work;
 
+static ev_t *cfg_watch_ev;
+
 /**********************************************************************************************************************
  * LOCAL FUNCTION DECLARATION
  *********************************************************************************************************************/
@@ -67,61 +83,76 @@ void run_tim_ev(ev_t *event) {
     uv_timer_start((uv_timer_t *)event->handle, event->tim_cb, timeout, repeat);
 }
 
-/**********************************************************************************************************************
- * GLOBAL FUNCTION DEFINITION
- *********************************************************************************************************************/
-void hab_init(void) {
-    stdret_t ret = STD_NOT_OK;
-    habtrig_t *habtrig = NULL;
-    habdev_t *habdev = NULL;
-    ev_glob_t *event = NULL;
+void run_fs_ev(ev_t *event) {
+    int ret = 0;
 
-    char led_buff[4] = {0};
+    uv_fs_event_init(loop, (uv_fs_event_t *)event->handle);
+    ret = uv_fs_event_start((uv_fs_event_t *)event->handle, event->fs_cb, event->hcfg.fs_path, 0);
+    if (ret < 0)
+        fprintf(stderr, "ERROR: Could not watch %s: %s\n", event->hcfg.fs_path, uv_strerror(ret));
+}
+
+static void setup_triggers(void) {
+    habtrig_t *habtrig = NULL;
 
     /* 1. TRIGGER SETUP */
     for (int i = 0; i < ARRAY_SIZE(trig_val_list); i++) {
         habtrig = habtrig_alloc();
         habtrig->index = i;
         if (trig_val_list[i] > 0)
-            ret = habtrig_register(habtrig, trig_val_list[i]);
+            (void)habtrig_register(habtrig, trig_val_list[i]);
     }
+}
+
+static void alloc_global_events(void) {
+    ev_glob_t *event = NULL;
 
-    habdev_preinit();
     /* 2.0 Global event allocation */
     for (int i = 0; i < event_getGlobalNum(); i++) {
         event = event_allocGlobalEv();
         event_registerGlobalEv(event, i);
     }
+}
 
-    /* 2. DEVICE ALLOCATION */
-    for (int i = 0; i < ARRAY_SIZE(dev_idx_list); i++) {
-        habdev = habdev_alloc();
-        ret = habdev_register(habdev, dev_idx_list[i]);
-    
-        if (ret == STD_NOT_OK) {
-            fprintf(stderr, "Error registering the device: %s\n", habdev->path.dev_name);
-            /* Error loop instead of exiting? */
-            // exit(-1);
-        }
+static stdret_t register_device(const u32 dev_idx) {
+    stdret_t ret = STD_NOT_OK;
+    habdev_t *habdev = NULL;
+
+    habdev = habdev_alloc();
+    ret = habdev_register(habdev, dev_idx);
+
+    if (ret == STD_NOT_OK) {
+        fprintf(stderr, "Error registering the device: %s\n", habdev->path.dev_name);
+        /* Error loop instead of exiting? */
+        // exit(-1);
     }
-    habdev_postinit();
 
-    snprintf(led_buff, sizeof(ret), "%d", ret);
+    return ret;
+}
+
+static void alloc_cfg_watch(void) {
+    /* 3. CONFIGURATION WATCH */
+    cfg_watch_ev = event_alloc();
+    if (NULL != cfg_watch_ev)
+        (void)event_registerFsEv(cfg_watch_ev, HAB_DEV_CFG_PATH, cfg_reload_callback);
+}
+
+static void set_led(const stdret_t status) {
+    char led_buff[4] = {0};
+
+    snprintf(led_buff, sizeof(led_buff), "%d", status);
     write_file(HAB_LED_PATH, led_buff, sizeof(led_buff), MOD_W);
 }
 
-int hab_run(void) {
-    int ret = 0;
-    habdev_t *habdev = NULL;
-    ev_glob_t *event = NULL;
+static void start_device(const u32 dev_idx) {
+    habdev_t *habdev = habdev_get(dev_idx);
 
-    loop = uv_default_loop();
+    if (NULL != habdev && NULL != habdev->event && event_getEvIdx(dev_idx) >= 0)
+        run_tim_ev(habdev->event);
+}
 
-    for (int i = 0; i < event_getDevNum(); i++) {
-        habdev = habdev_get(event_getDevIdx(i));
-        if (NULL != habdev)
-            run_tim_ev(habdev->event);
-    }
+static void start_global_events(void) {
+    ev_glob_t *event = NULL;
 
     for (int i = 0; i < event_getGlobalNum(); i++) {
         event = event_getGlobalEv(i);
@@ -129,5 +160,207 @@ int hab_run(void) {
             run_tim_ev(event->ev);
     }
 
+    if (NULL != cfg_watch_ev && NULL != cfg_watch_ev->hcfg.fs_path)
+        run_fs_ev(cfg_watch_ev);
+}
+
+static bool is_enabled(const u32 dev_idx) {
+    for (int i = 0; i < ARRAY_SIZE(dev_idx_list); i++) {
+        if (dev_idx == dev_idx_list[i])
+            return true;
+    }
+    return false;
+}
+
+static bool is_iio_device(const u32 dev_idx) {
+    dev_type_t dev_type = habdev_getCfgType(dev_idx);
+
+    return DEV_IIO == dev_type || DEV_IIO_BUFF == dev_type;
+}
+
+static void attach_device(const u32 dev_idx) {
+    habdev_t *habdev = habdev_get(dev_idx);
+
+    /* A re-probed device comes up with kernel defaults, the configuration has to be written again */
+    if (NULL != habdev) {
+        (void)habdev_reload(habdev);
+        return;
+    }
+
+    cfgtree_initDfa();
+    if (STD_OK == register_device(dev_idx))
+        start_device(dev_idx);
+    cfgtree_freeDfa();
+}
+
+static void on_dev_uevent(const uevent_t *uev) {
+    s32 dev_idx = -1;
+
+    if (NULL == uev->subsystem || 0 != str_compare(uev->subsystem, IIO_SUBSYSTEM))
+        return;
+
+    if (0 == str_compare(uev->action, UEVENT_ACTION_REMOVE)) {
+        dev_idx = iiodisc_detach(uev->kobj_name);
+        if (dev_idx >= 0)
+            fprintf(stderr, "ERROR: Device with index %d left the IIO bus.\n", dev_idx);
+        return;
+    }
+
+    if (0 != str_compare(uev->action, UEVENT_ACTION_ADD))
+        return;
+
+    dev_idx = iiodisc_attach(uev->kobj_name);
+    if (dev_idx >= 0 && is_enabled((u32)dev_idx))
+        attach_device((u32)dev_idx);
+}
+
+static void watch_devices(void) {
+    if (STD_NOT_OK == uevent_addListener(loop, on_dev_uevent))
+        fprintf(stderr, "ERROR: Device hotplug is not monitored, late devices will not be attached.\n");
+}
+
+/* Phase changes are rare, each one is kept with the sample that caused it */
+static void on_flight_phase(const ev_msg_t *msg, void *ctx) {
+    char path_buff[128] = {0};
+    char line_buff[96] = {0};
+
+    (void)ctx;
+
+    printf("INFO: Flight phase %s -> %s\n", ffdet_getPhaseName(msg->data.flight_phase.prev),
+           ffdet_getPhaseName(msg->data.flight_phase.phase));
+
+    snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DATASTORAGE_PATH, FLIGHT_PHASE_LOG);
+    snprintf(line_buff, sizeof(line_buff), "%llu %s %s %u\n", (unsigned long long)msg->ts_ns,
+             ffdet_getPhaseName(msg->data.flight_phase.prev), ffdet_getPhaseName(msg->data.flight_phase.phase),
+             msg->data.flight_phase.accel_mg);
+    if (STD_NOT_OK == write_file(path_buff, line_buff, strlen(line_buff), MOD_A))
+        fprintf(stderr, "ERROR: Flight phase change is not stored.\n");
+
+    /* The fall is confirmed some scans after it started, the pre-trigger rings still hold its onset */
+    if (FFDET_FALL == msg->data.flight_phase.phase)
+        iiobuff_capture("free_fall");
+}
+
+/* One line per fused batch, a few a second */
+static void on_altitude(const ev_msg_t *msg, void *ctx) {
+    char path_buff[128] = {0};
+    char line_buff[80] = {0};
+    int len = 0;
+
+    (void)ctx;
+
+    snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DATASTORAGE_PATH, ALTITUDE_LOG);
+    len = snprintf(line_buff, sizeof(line_buff), "%llu %d %d %d\n", (unsigned long long)msg->ts_ns,
+                   msg->data.altitude.alt_mm, msg->data.altitude.climb_mms, msg->data.altitude.baro_mm);
+    if (STD_NOT_OK == write_file(path_buff, line_buff, (usize)len, MOD_A))
+        fprintf(stderr, "ERROR: Altitude estimate is not stored.\n");
+    budget_account(BUDGET_SENSOR, (usize)len);
+}
+
+static void start_services(void) {
+    if (STD_NOT_OK == budget_start(loop))
+        fprintf(stderr, "ERROR: Storage budget is not tracked, media may fill the card.\n");
+    if (STD_NOT_OK == habtime_start(loop))
+        fprintf(stderr, "ERROR: Time anchors are not recorded, logs can not be mapped to the wall clock.\n");
+    if (STD_NOT_OK == telem_open())
+        fprintf(stderr, "ERROR: Telemetry segment %s is not published.\n", TELEM_SHM_NAME);
+    (void)event_subscribe(EV_TOPIC_FLIGHT_PHASE, on_flight_phase, NULL);
+    if (STD_NOT_OK == altfus_init())
+        fprintf(stderr, "ERROR: Altitude is not estimated.\n");
+    else
+        (void)event_subscribe(EV_TOPIC_ALTITUDE, on_altitude, NULL);
+}
+
+static void boot_core_ready(void) {
+    setup_triggers();
+
+    habdev_preinit();
+    alloc_global_events();
+
+    /* Devices that are not on the IIO bus do not depend on any kernel module */
+    for (usize i = 0; i < ARRAY_SIZE(dev_idx_list); i++) {
+        if (is_iio_device(dev_idx_list[i])) {
+            boot_expectDev(dev_idx_list[i]);
+        } else if (STD_OK == register_device(dev_idx_list[i])) {
+            start_device(dev_idx_list[i]);
+        }
+    }
+}
+
+static void boot_dev_ready(const u32 dev_idx) {
+    if (STD_OK == register_device(dev_idx))
+        start_device(dev_idx);
+}
+
+static void boot_done(const usize missing) {
+    habdev_postinit();
+    alloc_cfg_watch();
+
+    /* Global events aggregate all devices, start them once the device set is final */
+    start_global_events();
+    watch_devices();
+    start_services();
+    set_led((0 == missing) ? STD_OK : STD_NOT_OK);
+
+    printf("INFO: Boot finished, %zu device(s) missing.\n", missing);
+}
+
+static const boot_ops_t boot_ops = {
+    .core_ready = boot_core_ready,
+    .dev_ready  = boot_dev_ready,
+    .done       = boot_done,
+};
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+void hab_init(void) {
+    stdret_t ret = STD_OK;
+
+    setup_triggers();
+
+    habdev_preinit();
+    alloc_global_events();
+
+    /* 2. DEVICE ALLOCATION. IIO devices that did not probe yet are attached on their uevent */
+    for (usize i = 0; i < ARRAY_SIZE(dev_idx_list); i++) {
+        if (is_iio_device(dev_idx_list[i]) && !iiodisc_isPresent(dev_idx_list[i])) {
+            fprintf(stderr, "ERROR: Device with index %u is not on the IIO bus yet.\n", dev_idx_list[i]);
+            ret = STD_NOT_OK;
+            continue;
+        }
+        if (STD_NOT_OK == register_device(dev_idx_list[i]))
+            ret = STD_NOT_OK;
+    }
+    habdev_postinit();
+
+    alloc_cfg_watch();
+    set_led(ret);
+}
+
+int hab_run(void) {
+    loop = uv_default_loop();
+
+    /* Sensor logs are appended from the loop thread, keep them above the media writers */
+    (void)shaper_setThreadClass(BUDGET_SENSOR);
+
+    for (int i = 0; i < (int)event_getDevNum(); i++)
+        start_device(event_getDevIdx(i));
+
+    start_global_events();
+    watch_devices();
+    start_services();
+
+    return uv_run(loop, UV_RUN_DEFAULT);
+}
+
+int hab_boot(void) {
+    loop = uv_default_loop();
+
+    /* Sensor logs are appended from the loop thread, keep them above the media writers */
+    (void)shaper_setThreadClass(BUDGET_SENSOR);
+
+    boot_start(loop, &boot_ops);
+
     return uv_run(loop, UV_RUN_DEFAULT);
 }
@@ -0,0 +1,42 @@
+/**********************************************************************************************************************
+* hab_clock.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Monotonic clock of the timestamp service, split from hab_time.cpp so the post-flight tools can link           *
+*       it without libuv.                                                                                             *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       u64                 habtime_nowNs(void);                                                                      *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <time.h>
+
+#include "hab_clock.h"
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+u64 habtime_nowNs(void) {
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec * NANO + (u64)ts.tv_nsec;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+* hab_time.cpp                                                                                                        *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Timestamp service. The realtime sample of an anchor is taken between two monotonic reads, the anchor          *
+*       holds their midpoint and half of their distance as the uncertainty of the pair.                               *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            habtime_start(uv_loop_t *loop);                                                           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils.h"
+#include "hab_time.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define HABTIME_NS_IN_S         1000000000ULL
+/* Anchors with a wider bracket are retried, the thread was likely preempted between the reads */
+#define HABTIME_BRACKET_MAX_NS  20000ULL
+#define HABTIME_SAMPLE_TRIES    5
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static uv_timer_t *anchor_tim;
+static s64 last_offset;
+static u64 last_anchor_ns;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 read_clock(const clockid_t clk) {
+    struct timespec ts = {0};
+
+    clock_gettime(clk, &ts);
+
+    return (u64)ts.tv_sec * HABTIME_NS_IN_S + (u64)ts.tv_nsec;
+}
+
+static void sample_anchor(u64 *mono, u64 *real, u64 *uncert) {
+    u64 before = 0, after = 0;
+
+    for (int i = 0; i < HABTIME_SAMPLE_TRIES; i++) {
+        before = read_clock(CLOCK_MONOTONIC);
+        *real  = read_clock(CLOCK_REALTIME);
+        after  = read_clock(CLOCK_MONOTONIC);
+        if (after - before <= HABTIME_BRACKET_MAX_NS)
+            break;
+    }
+
+    *mono = before + (after - before) / 2U;
+    *uncert = (after - before) / 2U;
+}
+
+static void write_anchor(void) {
+    char path_buff[128] = {0};
+    char line_buff[80] = {0};
+    u64 mono = 0, real = 0, uncert = 0;
+
+    sample_anchor(&mono, &real, &uncert);
+    last_offset = (s64)(real - mono);
+    last_anchor_ns = mono;
+
+    snprintf(path_buff, sizeof(path_buff), "%s%s", HAB_DATASTORAGE_PATH, HABTIME_ANCHOR_FILE);
+    snprintf(line_buff, sizeof(line_buff), "%llu %llu %llu\n",
+             (unsigned long long)mono, (unsigned long long)real, (unsigned long long)uncert);
+
+    if (STD_NOT_OK == write_file(path_buff, line_buff, strlen(line_buff), MOD_A))
+        fprintf(stderr, "ERROR: Time anchor is not stored.\n");
+}
+
+static void on_anchor_tim(uv_timer_t *handle) {
+    s64 offset = (s64)(read_clock(CLOCK_REALTIME) - read_clock(CLOCK_MONOTONIC));
+    s64 drift = offset - last_offset;
+
+    (void)handle;
+
+    /* A stepped wall clock (NTP, GPS, RTC) gets its anchor right away */
+    if (drift > HABTIME_STEP_NS || drift < -HABTIME_STEP_NS ||
+        habtime_nowNs() - last_anchor_ns >= (u64)HABTIME_ANCHOR_MS * MICRO)
+        write_anchor();
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t habtime_start(uv_loop_t *loop) {
+    if (NULL != anchor_tim)
+        return STD_OK;
+
+    anchor_tim = (uv_timer_t *)malloc(sizeof(uv_timer_t));
+    if (NULL == anchor_tim)
+        return STD_NOT_OK;
+
+    write_anchor();
+
+    uv_timer_init(loop, anchor_tim);
+    uv_timer_start(anchor_tim, on_anchor_tim, HABTIME_CHECK_MS, HABTIME_CHECK_MS);
+
+    return STD_OK;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -9,12 +9,13 @@
 *       habtrig_t*          habtrig_alloc(void);                                                                      *
 *       void                habtrig_free(habtrig_t *trig);                                                            *
 *       stdret_t            habtrig_register(habtrig_t *trig, u32 period_ms);                                         *
+*       s32                 habtrig_lookup(const char *name);                                                         *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
 *                                                                                                                     *
 * VERSION                                                                                                             *
-*       0.0.1               last modification: 13-04-2024                                                             *
+*       0.0.2               last modification: 19-10-2026                                                             *
 *                                                                                                                     *
 * LICENSE                                                                                                             *
 *       GPL                                                                                                           *
@@ -26,8 +27,12 @@
  *********************************************************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <dirent.h>
 #include <sys/stat.h>
 
 #include "hab_trig.h"
@@ -41,31 +46,135 @@
 #define IIO_HRTRIG_SF_SUBPATH    "/sampling_frequency"
 #define IIO_HRTRIG_BASENAME      "trigger"
 
+#define IIO_HRTRIG_NAME_SUBPATH  "/name"
+
 #define HAB_HRTRIG_BASENAME      "habtrig-"
 
+/* Power of two, lookups mask the hash instead of dividing */
+#define TRIG_HT_SIZE             64U
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+/* Trigger name -> N of /sys/bus/iio/devices/triggerN */
+typedef struct {
+    char name[64];
+    s32  num;
+} trig_entry_t;
+
 /**********************************************************************************************************************
  * GLOBAL VARIABLES DECLARATION
  *********************************************************************************************************************/
 static habtrig_t *habtrig_list[64];
 static int       habtrig_cnt;
 
+static trig_entry_t trig_ht[TRIG_HT_SIZE];
+static usize        trig_ht_cnt;
+static bool         trig_scanned;
+
 /**********************************************************************************************************************
  * LOCAL FUNCTION DECLARATION
  *********************************************************************************************************************/
 static stdret_t write_period(const habtrig_t *trig, u32 period_ms);
+static void scan_triggers(void);
 
 /**********************************************************************************************************************
  * LOCAL FUNCTION DEFINITION
  *********************************************************************************************************************/
+static u32 hash_name(const char *name) {
+    /* FNV-1a */
+    u32 hash = 2166136261U;
+
+    while ('\0' != *name) {
+        hash ^= (u8)*name++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static trig_entry_t *find_slot(const char *name) {
+    u32 pos = hash_name(name) & (TRIG_HT_SIZE - 1);
+
+    for (usize i = 0; i < TRIG_HT_SIZE; i++) {
+        trig_entry_t *entry = &trig_ht[(pos + i) & (TRIG_HT_SIZE - 1)];
+        if ('\0' == entry->name[0] || 0 == str_compare(name, entry->name))
+            return entry;
+    }
+
+    return NULL;
+}
+
+static void insert_trigger(const char *name, const s32 num) {
+    trig_entry_t *entry = find_slot(name);
+
+    /* Keep one slot free, so a miss always terminates on an empty entry */
+    if (NULL == entry || ('\0' == entry->name[0] && trig_ht_cnt >= TRIG_HT_SIZE - 1)) {
+        fprintf(stderr, "ERROR: Trigger table is full, %s is not registered.\n", name);
+        return;
+    }
+
+    if ('\0' == entry->name[0])
+        trig_ht_cnt++;
+
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->num = num;
+}
+
+static void scan_triggers(void) {
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    int fd = -1;
+    ssize_t len = 0;
+    s32 num = 0;
+    char path_buff[128] = {0};
+    char name[64] = {0};
+
+    /* Entries are updated in place, the table stays usable while the directory is walked */
+    trig_scanned = true;
+
+    dir = opendir(IIO_HRTRIG_SYSFS_PATH);
+    if (NULL == dir)
+        return;
+
+    while (NULL != (entry = readdir(dir))) {
+        if (1 != sscanf(entry->d_name, IIO_HRTRIG_BASENAME "%d", &num))
+            continue;
+
+        snprintf(path_buff, sizeof(path_buff), "%s%s%d%s",
+                 IIO_HRTRIG_SYSFS_PATH, IIO_HRTRIG_BASENAME, num, IIO_HRTRIG_NAME_SUBPATH);
+        fd = open(path_buff, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            continue;
+
+        memset(name, 0, sizeof(name));
+        len = read(fd, name, sizeof(name) - 1);
+        close(fd);
+
+        if (len > 0) {
+            CROP_NEWLINE(name, strlen(name));
+            insert_trigger(name, num);
+        }
+    }
+
+    closedir(dir);
+}
+
 static stdret_t write_period(const habtrig_t *trig, u32 period_ms) {
     stdret_t ret = STD_NOT_OK;
     float freq = 1 * MILLI / (float)period_ms;
+    s32 num = habtrig_lookup(trig->name);
 
     char path_buff[128] = {0};
     char write_buff[16]  = {0};
 
+    if (num < 0) {
+        fprintf(stderr, "ERROR: Trigger %s is not present in %s\n", trig->name, IIO_HRTRIG_SYSFS_PATH);
+        return STD_NOT_OK;
+    }
+
     snprintf(path_buff, sizeof(path_buff), "%s%s%d%s", 
-                IIO_HRTRIG_SYSFS_PATH, IIO_HRTRIG_BASENAME, trig->index, IIO_HRTRIG_SF_SUBPATH);
+                IIO_HRTRIG_SYSFS_PATH, IIO_HRTRIG_BASENAME, num, IIO_HRTRIG_SF_SUBPATH);
     snprintf(write_buff, sizeof(write_buff), "%f", freq);
 
     ret = write_file(path_buff, write_buff, sizeof(write_buff), MOD_W);
@@ -82,27 +191,43 @@ stdret_t habtrig_register(habtrig_t *trig, u32 period_ms) {
 
     char trig_path[128]  = {0};
 
+    trig->period_ms = period_ms;
     snprintf(trig_path, sizeof(trig_path), "%s%s%d", IIO_HRTRIG_CONFIGFS_PATH, HAB_HRTRIG_BASENAME, period_ms);
 
     mkdir_ret = mkdir(trig_path, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
 
-    if (mkdir_ret >= 0) {
-        trig->period_ms = period_ms;
+    /* A trigger left over from a previous run is reused as is */
+    if (mkdir_ret >= 0 || EEXIST == errno) {
         trig->type = T_HRTIM;
         snprintf(trig->name, sizeof(trig->name), "%s%d", HAB_HRTRIG_BASENAME, trig->period_ms);
 
+        /* Triggers only appear here after the first scan, a new one is added to the table right away */
+        if (mkdir_ret >= 0)
+            scan_triggers();
+
         ret = write_period(trig, period_ms);
     }
 
     return ret;
 }
 
+s32 habtrig_lookup(const char *name) {
+    trig_entry_t *entry = NULL;
+
+    if (!trig_scanned)
+        scan_triggers();
+
+    entry = find_slot(name);
+
+    return (NULL != entry && '\0' != entry->name[0]) ? entry->num : -1;
+}
+
 
 habtrig_t *habtrig_alloc(void) {
     int ret = 0;
     habtrig_t *habtrig   = NULL;
 
-    habtrig = (habtrig_t *)malloc(sizeof(habtrig_t));
+    habtrig = (habtrig_t *)calloc(1, sizeof(habtrig_t));
 
     if (habtrig) {
         habtrig->id = habtrig_cnt;
@@ -115,8 +240,8 @@ habtrig_t *habtrig_alloc(void) {
 habtrig_t *habtrig_get(const int index) {
     habtrig_t *trig = NULL;
 
-    for (usize i = 0; i < ARRAY_SIZE(habtrig_list); i++) {
-        if (index == habtrig_list[i]->index) {
+    for (int i = 0; i < habtrig_cnt; i++) {
+        if (NULL != habtrig_list[i] && index == habtrig_list[i]->index) {
             trig = habtrig_list[i];
             break;
         }
@@ -7,6 +7,7 @@
 *                                                                                                                     *
 * PUBLIC FUNCTIONS :                                                                                                  *
 *       stdret_t            iiobuff_log2file(char *ubuff, const habdev_t *habdev)                                     *
+*       int                 iiobuff_getBatch(const s64 **vals, const double **si)                                     *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -28,9 +29,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 #include "utils.h"
 #include "iio_buffer_ops.h"
+#include "iio_scan.h"
+#include "iio_discovery.h"
+#include "log_codec.h"
+#include "log_zip.h"
+#include "storage.h"
+#include "storage_budget.h"
+#include "telemetry.h"
+#include "hab_time.h"
+#include "iio_stats.h"
+#include "iio_capture.h"
+#include "event.h"
+#include "iio_conv.h"
 
 /**********************************************************************************************************************
  *  MACRO
@@ -39,10 +55,9 @@
 # error "ERROR: Path to buffer configuration folder is not specified."
 #endif
 
-#define IRQ_LIST_PATH         "/proc/interrupts"
-#define BUFF_DATA_RDY_SUBPATH "buffer/data_available"
+/* Hexdump line of a record with room for the appended string */
+#define IIOBUFF_HEX_REC_LEN  128U
 
-#define IRQ_TRIG_BASENAME  "irqtrig-"
 
 /**********************************************************************************************************************
  * LOCAL TYPEDEFS DECLARATION
@@ -52,13 +67,39 @@
 /**********************************************************************************************************************
  * GLOBAL VARIABLES DECLARATION
  *********************************************************************************************************************/
+static const u8 dev_log_fmt[] = HAB_DEV_LOG_FMT;
+
+static logcodec_t    *codec_list[ARRAY_SIZE(dev_log_fmt)];
+/* Time the pending block of a device got its first record */
+static u64           codec_ns[ARRAY_SIZE(dev_log_fmt)];
+static u8            codec_out[LOGCODEC_BLOCK_MAX];
+
+static logzip_t      *zip_list[ARRAY_SIZE(dev_log_fmt)];
+
+static storage_t *store_list[ARRAY_SIZE(dev_log_fmt)];
+static char      hex_out[IIOBUFF_READ_LEN / HEXDUMP_RECORD_LEN * IIOBUFF_HEX_REC_LEN];
+
+/* Channels of a whole read batch, a scan holds at least one byte per value */
+static s64       scan_vals[IIOBUFF_READ_LEN];
+/* The same values in the units of the IIO ABI, see iio_conv.h */
+static double    scan_si[IIOBUFF_READ_LEN];
+static int       batch_num;
+
+static iiostats_t *stats_list[ARRAY_SIZE(dev_log_fmt)];
+static iiostats_cfg_t stats_cfg[ARRAY_SIZE(dev_log_fmt)];
+static char      stats_out[4U * IIOSTATS_LINE_MAX];
+
+static iiocap_t     *cap_list[ARRAY_SIZE(dev_log_fmt)];
+static iiocap_cfg_t cap_cfg[ARRAY_SIZE(dev_log_fmt)];
+static u8           cap_rec[IIOBUFF_READ_LEN];
 
 
 /**********************************************************************************************************************
  * LOCAL FUNCTION DECLARATION
  *********************************************************************************************************************/
 static void flip_nibbles(char *buffer, usize size);
-static stdret_t find_irq_trigger(habdev_t *habdev);
+static stdret_t log_encoded(const habdev_t *habdev, const u8 *data, usize size);
+static stdret_t log_zipped(const habdev_t *habdev, const u8 *data, usize size);
 
 
 /**********************************************************************************************************************
@@ -74,119 +115,468 @@ static void flip_nibbles(char *buffer, usize size) {
     }
 }
 
-static stdret_t find_irq_trigger(habdev_t *habdev) {
-    stdret_t ret;
-    char line[128] = {0};
-    char word[64]  = {0};
-    char first_word[32] = {0};
+static storage_t *get_store(const habdev_t *habdev) {
+    char log_path[64] = {0};
+
+    if (NULL != store_list[habdev->index])
+        return store_list[habdev->index];
+
+    habdev_getLogPath(habdev, log_path, sizeof(log_path));
+    if (LOGFMT_DELTA == dev_log_fmt[habdev->index])
+        strncat(log_path, LOGCODEC_FILE_EXT, sizeof(log_path) - strlen(log_path) - 1);
+    else if (LOGFMT_ZIP == dev_log_fmt[habdev->index])
+        strncat(log_path, LOGZIP_FILE_EXT, sizeof(log_path) - strlen(log_path) - 1);
 
-    usize fpos = 0;
-    usize lpos = 0;
+    /* Binary logs are framed, so a log torn by a power loss is resumed after its last valid block */
+    store_list[habdev->index] = storage_open(log_path, LOGFMT_HEX != dev_log_fmt[habdev->index]);
+
+    return store_list[habdev->index];
+}
 
-    bool repeat = true;
-    bool line_begin = true;
+static u16 sign_mask(const habdev_t *habdev) {
+    u16 mask = 0;
 
-    while(get_line(IRQ_LIST_PATH, &fpos, line, sizeof(line)) >= 0 && repeat) {
-        while(get_word(line, &lpos, word, sizeof(word)) >= 0 && repeat) {
-            if (line_begin) {
-                line_begin = false;
-                strcpy(first_word, word);
-            }
+    for (u8 i = 0; i < min(habdev->df.chan_num, habdev->conv.chan_num); i++)
+        mask |= (u16)(habdev->conv.chan[i].is_signed << i);
 
-            if (0 == str_compare(habdev->path.dev_name, word)) {
-                repeat = false;
-            }
+    return mask;
+}
+
+static bool codec_changed(const logcodec_t *codec, const habdev_t *habdev) {
+    return codec->chan_num != habdev->df.chan_num || codec->ts_en != habdev->df.ts_en ||
+           codec->sign_mask != sign_mask(habdev) ||
+           0 != memcmp(codec->storagebits, habdev->df.storagebits, codec->chan_num);
+}
+
+/**
+ * A partial block is held until a full one is overdue, so slow devices fill whole blocks as well:
+ * the trigger period times the block length plus the drain period, at least LOGCODEC_FLUSH_MS.
+ */
+static u64 seal_ms(const habdev_t *habdev) {
+    u64 hold_ms = 0;
+
+    if (NULL != habdev->trig)
+        hold_ms = (u64)habdev->trig->period_ms * LOGCODEC_BLOCK_REC;
+    if (NULL != habdev->event)
+        hold_ms += (u64)max(habdev->event->hcfg.tim_ev.tim_rep, 0);
+
+    return max(hold_ms, (u64)LOGCODEC_FLUSH_MS);
+}
+
+static stdret_t log_encoded(const habdev_t *habdev, const u8 *data, usize size) {
+    stdret_t ret = STD_OK;
+    usize len = 0;
+    logcodec_t **codec = &codec_list[habdev->index];
+    storage_t *store = get_store(habdev);
+    u64 now = habtime_nowNs();
+
+    if (NULL == store)
+        return STD_NOT_OK;
+
+    /* Columns follow the scan layout, a reconfigured buffer starts a new block */
+    if (NULL != *codec && codec_changed(*codec, habdev)) {
+        len = logcodec_flush(*codec, codec_out, sizeof(codec_out));
+        if (len > 0) {
+            ret = storage_write(store, codec_out, len);
+            budget_account(BUDGET_SENSOR, len);
         }
-        lpos = 0;
-        line_begin = true;
+        logcodec_free(*codec);
+        *codec = NULL;
+    }
+
+    if (NULL == *codec) {
+        *codec = logcodec_alloc(&habdev->df, sign_mask(habdev));
+        if (NULL == *codec)
+            return STD_NOT_OK;
     }
 
-    /* If while loop was interrupted - device entry found. */
-    if (!repeat) {
-        CROP_LAST_CHAR(first_word, strlen(first_word));
-        snprintf(habdev->trig->name, sizeof(habdev->trig->name), "%s%s", IRQ_TRIG_BASENAME, first_word);
-        habdev->trig->type = T_IRQ;
-    
-        ret = STD_OK;
-    } else {
-        ret = STD_NOT_OK;
+    for (usize pos = 0; pos + (*codec)->scan_len <= size; pos += (*codec)->scan_len) {
+        if (0 == (*codec)->rec_num)
+            codec_ns[habdev->index] = now;
+        len = logcodec_push(*codec, data + pos, codec_out, sizeof(codec_out));
+        if (len > 0 && STD_NOT_OK == storage_write(store, codec_out, len))
+            ret = STD_NOT_OK;
+        budget_account(BUDGET_SENSOR, len);
     }
+
+    if ((*codec)->rec_num > 0 && now - codec_ns[habdev->index] >= seal_ms(habdev) * MICRO) {
+        len = logcodec_flush(*codec, codec_out, sizeof(codec_out));
+        if (len > 0 && STD_NOT_OK == storage_write(store, codec_out, len))
+            ret = STD_NOT_OK;
+        budget_account(BUDGET_SENSOR, len);
+    }
+
     return ret;
 }
 
+/* The last complete scan of the batch goes to the telemetry, stamped by the IIO timestamp when it is enabled */
+static void publish_scan(const habdev_t *habdev, int val_num) {
+    u8 chan_num = habdev->df.chan_num;
+    usize last = 0;
+    u64 ts = habtime_nowNs();
+
+    if (0 == chan_num || val_num < chan_num)
+        return;
+
+    /* Raw counts and the converted values of the last scan, scan_si is filled in the same layout */
+    last = (usize)(val_num - val_num % chan_num - chan_num);
+    if (habdev->df.ts_en)
+        ts = (u64)scan_vals[last + --chan_num];
+
+    telem_publish(habdev->index, scan_vals + last, scan_si + last, chan_num, ts, 0);
+}
+
+/* Consumers of decoded scans, e.g. the sensor fusion, take the whole batch on the bus */
+static void publish_batch(const habdev_t *habdev, int val_num) {
+    ev_msg_t msg = {0};
+
+    if (val_num <= 0)
+        return;
+
+    msg.topic = EV_TOPIC_SCAN;
+    msg.ts_ns = habtime_nowNs();
+    msg.data.scan.dev_idx = habdev->index;
+    msg.data.scan.val_num = (u32)val_num;
+    msg.data.scan.chan_num = habdev->df.chan_num;
+    msg.data.scan.ts_en = habdev->df.ts_en;
+    msg.data.scan.vals = scan_vals;
+    msg.data.scan.si = scan_si;
+
+    event_publish(&msg);
+}
+
+static bool stats_changed(const iiostats_cfg_t *old, const iiostats_cfg_t *new) {
+    return old->window != new->window || old->hop != new->hop || old->raw != new->raw;
+}
+
+static stdret_t write_stats(const char *path, usize len) {
+    budget_account(BUDGET_SENSOR, len);
+    return write_file(path, stats_out, len, MOD_A);
+}
+
+/* Summaries are a few lines per second at most, so they are appended to a csv next to the raw log */
+static stdret_t log_stats(const habdev_t *habdev, int val_num) {
+    iiostats_t **st = &stats_list[habdev->index];
+    u8 chan_num = habdev->df.chan_num - (habdev->df.ts_en ? 1U : 0U);
+    u8 scan_len = habdev->df.chan_num;
+    char path[64] = {0};
+    struct stat fst;
+    stdret_t ret = STD_OK;
+    usize len = 0;
+    u64 ts = 0;
+
+    if (0 == habdev->stats.window || 0 == chan_num)
+        return STD_OK;
+
+    /* A reconfigured device starts new windows */
+    if (NULL != *st && ((*st)->chan_num != chan_num || stats_changed(&stats_cfg[habdev->index], &habdev->stats))) {
+        iiostats_free(*st);
+        *st = NULL;
+    }
+
+    habdev_getLogPath(habdev, path, sizeof(path));
+    strncat(path, IIOSTATS_FILE_EXT, sizeof(path) - strlen(path) - 1);
+
+    if (NULL == *st) {
+        *st = iiostats_alloc(chan_num, &habdev->stats);
+        if (NULL == *st)
+            return STD_NOT_OK;
+        stats_cfg[habdev->index] = habdev->stats;
+
+        if (0 != stat(path, &fst) || 0 == fst.st_size)
+            len = iiostats_header(*st, stats_out, sizeof(stats_out));
+    }
+
+    for (int i = 0; i + scan_len <= val_num; i += scan_len) {
+        ts = habdev->df.ts_en ? (u64)scan_vals[i + chan_num] : habtime_nowNs();
+        len += iiostats_push(*st, &scan_vals[i], ts, stats_out + len, sizeof(stats_out) - len);
+
+        if (sizeof(stats_out) - len < IIOSTATS_LINE_MAX) {
+            ret |= write_stats(path, len);
+            len = 0;
+        }
+    }
+
+    if (len > 0)
+        ret |= write_stats(path, len);
+
+    return ret;
+}
+
+static bool cap_changed(const iiocap_cfg_t *old, const iiocap_cfg_t *new) {
+    return old->pre_ms != new->pre_ms || old->post_ms != new->post_ms || old->slope != new->slope;
+}
+
+static iiocap_t *get_capture(const habdev_t *habdev) {
+    iiocap_t **cap = &cap_list[habdev->index];
+
+    if (NULL != *cap && !cap_changed(&cap_cfg[habdev->index], &habdev->capture))
+        return *cap;
+
+    /* A reconfigured device drops its ring and a running capture */
+    iiocap_free(*cap);
+    *cap = iiocap_alloc(&habdev->capture);
+    cap_cfg[habdev->index] = habdev->capture;
+
+    return *cap;
+}
+
+static void capture_path(const habdev_t *habdev, const iiocap_t *cap, char *path, usize size) {
+    habdev_getLogPath(habdev, path, size);
+    snprintf(path + strlen(path), size - strlen(path), "_%llu%s", (unsigned long long)cap->trig_ns, IIOCAP_FILE_EXT);
+}
+
+/* The capture file stays open from the trigger to the end of the post time */
+static stdret_t capture_open(const habdev_t *habdev, iiocap_t *cap) {
+    char path[96] = {0};
+
+    if (cap->fd >= 0)
+        close(cap->fd);
+
+    capture_path(habdev, cap, path, sizeof(path));
+    cap->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, IIOCAP_FILE_MODE);
+    if (cap->fd < 0) {
+        fprintf(stderr, "ERROR: Could not open the capture file - %s\n", path);
+        return STD_NOT_OK;
+    }
+
+    return STD_OK;
+}
+
+static void capture_close(iiocap_t *cap) {
+    if (cap->fd < 0)
+        return;
+
+    close(cap->fd);
+    cap->fd = -1;
+}
+
+/* Captures are hexdumps like the default log, so hab_decode reads them as they are */
+static stdret_t capture_write(iiocap_t *cap, usize rec_num) {
+    ssize_t ret = 0;
+    usize len = 0, written = 0;
+
+    if (cap->fd < 0)
+        return STD_NOT_OK;
+
+    flip_nibbles((char *)cap_rec, rec_num * HEXDUMP_RECORD_LEN);
+    len = hexdump_str(hex_out, sizeof(hex_out), (const char *)cap_rec, rec_num, NULL);
+    budget_account(BUDGET_SENSOR, len);
+
+    while (written < len) {
+        ret = write(cap->fd, hex_out + written, len - written);
+        if (ret < 0 && EINTR == errno)
+            continue;
+        if (ret <= 0)
+            return STD_NOT_OK;
+        written += (usize)ret;
+    }
+
+    return STD_OK;
+}
+
+/**
+ * Sample time of the first and the last record of a batch. The timestamp channel gives the time of its scans,
+ * without one the batch is spread over the time since the previous one, as the records waited in the buffer.
+ */
+static void capture_stamp(const habdev_t *habdev, const iiocap_t *cap, usize rec_num, int val_num,
+                          u64 *first_ns, u64 *last_ns) {
+    u8 chan_num = habdev->df.chan_num;
+    u64 now = habtime_nowNs();
+
+    if (habdev->df.ts_en && 0 != chan_num && val_num >= chan_num) {
+        *first_ns = (u64)scan_vals[chan_num - 1];
+        *last_ns = (u64)scan_vals[val_num - val_num % chan_num - 1];
+        return;
+    }
+
+    *last_ns = now;
+    *first_ns = (0 == cap->push_ns || cap->push_ns >= now) ? now : cap->push_ns + (now - cap->push_ns) / rec_num;
+}
+
+/* The raw records go to the ring or a running capture, the first channel may trigger a capture of every device */
+static void capture_scan(const habdev_t *habdev, const u8 *data, usize rec_num, int val_num) {
+    iiocap_t *cap = get_capture(habdev);
+    u8 chan_num = habdev->df.chan_num;
+    char reason[32] = {0};
+    usize fwd = 0;
+    u64 ts = 0, first_ns = 0, last_ns = 0;
+
+    if (NULL == cap || 0 == rec_num)
+        return;
+
+    capture_stamp(habdev, cap, rec_num, val_num, &first_ns, &last_ns);
+    fwd = iiocap_push(cap, data, rec_num, first_ns, last_ns);
+    if (fwd > 0) {
+        memcpy(cap_rec, data, fwd * HEXDUMP_RECORD_LEN);
+        if (STD_NOT_OK == capture_write(cap, fwd))
+            fprintf(stderr, "ERROR: Capture of %s is incomplete.\n", habdev->path.dev_name);
+    }
+    if (IIOCAP_IDLE == cap->state)
+        capture_close(cap);
+
+    for (int i = 0; 0 != chan_num && i + chan_num <= val_num; i += chan_num) {
+        ts = habdev->df.ts_en ? (u64)scan_vals[i + chan_num - 1] : habtime_nowNs();
+        if (iiocap_checkSlope(cap, scan_vals[i], ts)) {
+            snprintf(reason, sizeof(reason), "slope_%s", habdev->path.dev_name);
+            iiobuff_capture(reason);
+            break;
+        }
+    }
+}
+
+/* The store of a compressed log is written by the compression worker only */
+static stdret_t log_zipped(const habdev_t *habdev, const u8 *data, usize size) {
+    logzip_t **zip = &zip_list[habdev->index];
+
+    if (NULL == *zip)
+        *zip = logzip_open(get_store(habdev));
+    if (NULL == *zip)
+        return STD_NOT_OK;
+
+    if (STD_NOT_OK == logzip_write(*zip, data, size))
+        return STD_NOT_OK;
+
+    return logzip_flush(*zip, false);
+}
+
 /**********************************************************************************************************************
  * GLOBAL FUNCTION DEFINITION
  *********************************************************************************************************************/
 int iiobuff_log2file(const habdev_t *habdev, const char *append, u8 *data_cpy) {
     stdret_t ret = STD_NOT_OK;
     int size = 0;
-    char blen[8] = {0};
-    char log_path[64] = {0};
-    char dev_path[128] = {0};
-    char data_buffer[4096] = {0};
+    int val_num = 0;
+    int fd = -1;
+    ssize_t len = 0;
+    usize scan_len = 0, group = 0;
+    char blen[16] = {0};
+    char data_buffer[IIOBUFF_READ_LEN] = {0};
+    storage_t *store = NULL;
+
+    batch_num = 0;
+
+    /* Both descriptors are opened once by the discovery and kept for the whole run */
+    fd = iiodisc_getFd(habdev->index, IIODISC_FD_DATA_AVAIL);
+    if (fd < 0 || pread(fd, blen, sizeof(blen) - 1, 0) <= 0) {
+        telem_setStatus(habdev->index, TELEM_ERROR);
+        return -1;
+    }
 
-    habdev_getDevPath(habdev, dev_path, sizeof(dev_path));
-    strcat(dev_path, BUFF_DATA_RDY_SUBPATH);
+    /**
+     * data_available counts scans. They are read in groups that fill whole records, e.g. 8 scans of 6 bytes
+     * in 3 records, so the logged stream is never cut inside a scan and keeps its channel phase. The lowest
+     * set bit of the scan size is its common divisor with the record length.
+     */
+    scan_len = iioscan_scanSize(&habdev->df);
+    if (0 == scan_len)
+        scan_len = HEXDUMP_RECORD_LEN;
+    group = HEXDUMP_RECORD_LEN / min(scan_len & (~scan_len + 1U), (usize)HEXDUMP_RECORD_LEN);
 
-    ret = read_file(dev_path, blen, sizeof(dev_path), MOD_R);
-    size = atoi(blen);
+    size = min(atoi(blen), (int)(sizeof(data_buffer) / scan_len));
+    size -= size % (int)group;
 
     if (size > 0) {
-        ret = read_file(habdev->path.buffer[0], data_buffer, size * HEXDUMP_RECORD_LEN, MOD_RW);
+        fd = iiodisc_getFd(habdev->index, IIODISC_FD_BUFF);
+        len = (fd < 0) ? -1 : read(fd, data_buffer, size * scan_len);
+        if (len <= 0) {
+            telem_setStatus(habdev->index, TELEM_ERROR);
+            return -1;
+        }
+
+        /* The buffer holds at least the scans reported, a read returns whole records */
+        size = len / HEXDUMP_RECORD_LEN;
         if (NULL != data_cpy)
             memcpy(data_cpy, data_buffer, sizeof(data_buffer));
 
-        flip_nibbles(data_buffer, size * HEXDUMP_RECORD_LEN);
-
-        habdev_getLogPath(habdev, log_path, sizeof(log_path));
-        ret = hexdump(log_path, data_buffer, size, append);   
-    }
-
-    return (ret == STD_OK) ? size * HEXDUMP_RECORD_LEN : -1;
-}
-
-int iiobuff_extract_data(data_format_t format, s64 *dst, const u8 *src, const usize size) {
-    usize batch_size = 0;
-    s64 chan_val = 0;
-    int dst_size = 0, chan_cnt = 0, pad = 0;
-    int data_remain = size;
-
-    for (int i = 0; i < format.chan_num; i++)
-        batch_size += format.storagebits[i] / BYTE;
-    
-    if (false == format.ts_en && (batch_size < 16))
-        batch_size = 16;
-    
-    /* Use case applicable for buffers such as icm20x */
-    // batch_size = min(n , HEXDUMP_RECORD_LEN);
-
-    for (usize i = 0; i < size; i += HEXDUMP_RECORD_LEN) {
-        for (usize j = 0; j < batch_size && data_remain > 0; ) {
-            pad = 0;
-            chan_cnt %= format.chan_num;
-            /**
-             * TBD Affter adding a setting we could also log a TS.
-             */
-            // if ((format.chan_num - 1 == chan_cnt) && format.ts_en)
-            //     pad = HEXDUMP_RECORD_LEN - batch_size;
-            
-            chan_val = merge_bytes(src + i + j + pad, format.storagebits[chan_cnt]);
-
-            /**
-             * For a buffer where ammount of data pushed does not devide without a remainder,
-             * an amount of bytes to be proccessed needs to be tracked.
-             * EXAMPLE - icm20x accelerometer. 
-             *     Single portion of data is 6 bytes. It means that hexdump line contains 2 full readouts.
-             *     The rest of thirt readout will be in the 0x10 hexdump line. Without tracking the remainder,
-             *     14 bytes in 0x10 line will unnececarilly stored. 
-             */
-            data_remain -= format.storagebits[chan_cnt] / BYTE;
-            j += format.storagebits[chan_cnt++] / BYTE;
-            dst[dst_size++] = chan_val;
+        val_num = iiobuff_extract_data(&habdev->df, scan_vals, (const u8 *)data_buffer, size * HEXDUMP_RECORD_LEN);
+        batch_num = (int)iioconv_toSI(&habdev->conv, scan_vals, scan_si, (usize)max(val_num, 0));
+        publish_scan(habdev, val_num);
+        publish_batch(habdev, val_num);
+        capture_scan(habdev, (const u8 *)data_buffer, size, val_num);
+        if (STD_NOT_OK == log_stats(habdev, val_num))
+            fprintf(stderr, "ERROR: Error logging statistics of device: %s\n", habdev->path.dev_name);
+
+        /* A device with statistics keeps the raw log on request only */
+        if (0 != habdev->stats.window && !habdev->stats.raw)
+            return size * HEXDUMP_RECORD_LEN;
+
+        /* The buffer is drained either way, a decimated batch is just not stored */
+        if (!budget_keepSensor(habdev->index))
+            return size * HEXDUMP_RECORD_LEN;
+
+        /* Raw records go through the compression stage */
+        if (LOGFMT_ZIP == dev_log_fmt[habdev->index])
+            return (STD_OK == log_zipped(habdev, (const u8 *)data_buffer, size * HEXDUMP_RECORD_LEN)) ?
+                   size * (int)HEXDUMP_RECORD_LEN : -1;
+
+        store = get_store(habdev);
+        if (NULL == store)
+            return -1;
+
+        /* Encoded logs carry the channel values only, the append string is a hexdump feature */
+        if (LOGFMT_DELTA == dev_log_fmt[habdev->index]) {
+            ret = log_encoded(habdev, (const u8 *)data_buffer, size * HEXDUMP_RECORD_LEN);
+        } else {
+            flip_nibbles(data_buffer, size * HEXDUMP_RECORD_LEN);
+            len = hexdump_str(hex_out, sizeof(hex_out), data_buffer, size, append);
+            ret = storage_write(store, hex_out, len);
+            budget_account(BUDGET_SENSOR, len);
         }
+
+        /* Every read batch is a flush point */
+        if (STD_OK == ret)
+            ret = storage_flush(store);
     }
 
-    return dst_size;
+    return (ret == STD_OK) ? size * (int)HEXDUMP_RECORD_LEN : -1;
+}
+
+void iiobuff_capture(const char *reason) {
+    const habdev_t *habdev = NULL;
+    char path[96] = {0};
+    char line[160] = {0};
+    usize num = 0;
+    u64 now = habtime_nowNs();
+
+    for (u32 i = 0; i < ARRAY_SIZE(cap_list); i++) {
+        if (NULL == cap_list[i] || !iiocap_trigger(cap_list[i], now))
+            continue;
+
+        habdev = habdev_get(i);
+        if (NULL == habdev)
+            continue;
+
+        /* The pre-trigger part is written at once, the rest follows with every read */
+        if (STD_NOT_OK == capture_open(habdev, cap_list[i]))
+            fprintf(stderr, "ERROR: Capture of %s is incomplete.\n", habdev->path.dev_name);
+        while ((num = iiocap_drain(cap_list[i], cap_rec, sizeof(cap_rec) / HEXDUMP_RECORD_LEN)) > 0) {
+            if (STD_NOT_OK == capture_write(cap_list[i], num))
+                fprintf(stderr, "ERROR: Capture of %s is incomplete.\n", habdev->path.dev_name);
+        }
+
+        capture_path(habdev, cap_list[i], path, sizeof(path));
+        printf("INFO: Capture of %s triggered by %s.\n", habdev->path.dev_name, reason);
+
+        snprintf(line, sizeof(line), "%llu %s %s\n", (unsigned long long)now, reason, path);
+        if (STD_NOT_OK == write_file(HAB_DATASTORAGE_PATH IIOCAP_INDEX_FILE, line, strlen(line), MOD_A))
+            fprintf(stderr, "ERROR: Capture of %s is not indexed.\n", habdev->path.dev_name);
+    }
+}
+
+int iiobuff_extract_data(const data_format_t *format, s64 *dst, const u8 *src, const usize size) {
+    u8 chan_idx = 0;
+
+    return iioscan_extract(format, &chan_idx, dst, src, size);
+}
+
+int iiobuff_getBatch(const s64 **vals, const double **si) {
+    if (NULL != vals)
+        *vals = scan_vals;
+    if (NULL != si)
+        *si = scan_si;
+
+    return batch_num;
 }
 
 /***********************************************************************************************************************
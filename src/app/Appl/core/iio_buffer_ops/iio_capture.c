@@ -0,0 +1,167 @@
+/**********************************************************************************************************************
+* iio_capture.cpp                                                                                                     *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Pre-trigger ring of raw buffer records. Records are copied into the ring while no capture runs, each          *
+*       with the time it was sampled. A trigger drops what is older than the pre time, the caller drains the rest     *
+*       and gets the records of the post time forwarded by the push. Triggers during a capture are ignored.           *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       iiocap_t *          iiocap_alloc(const iiocap_cfg_t *cfg);                                                    *
+*       usize               iiocap_push(iiocap_t *cap, const u8 *rec, usize rec_num, u64 first_ns, u64 last_ns);      *
+*       bool                iiocap_trigger(iiocap_t *cap, u64 now);                                                   *
+*       usize               iiocap_drain(iiocap_t *cap, u8 *out, usize rec_max);                                      *
+*       bool                iiocap_checkSlope(iiocap_t *cap, s64 val, u64 ts);                                        *
+*       void                iiocap_free(iiocap_t *cap);                                                               *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utils.h"
+#include "iio_capture.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define IIOCAP_NS_PER_MS    1000000ULL
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+iiocap_t *iiocap_alloc(const iiocap_cfg_t *cfg) {
+    iiocap_t *cap = NULL;
+
+    if (0 == cfg->post_ms)
+        return NULL;
+
+    cap = (iiocap_t *)calloc(1, sizeof(iiocap_t));
+    if (NULL == cap)
+        return NULL;
+
+    cap->rec = (u8 *)malloc(IIOCAP_RING_REC * HEXDUMP_RECORD_LEN);
+    if (NULL == cap->rec) {
+        free(cap);
+        return NULL;
+    }
+
+    cap->cfg = *cfg;
+    cap->state = IIOCAP_IDLE;
+    cap->fd = -1;
+
+    return cap;
+}
+
+usize iiocap_push(iiocap_t *cap, const u8 *rec, usize rec_num, u64 first_ns, u64 last_ns) {
+    u64 span = (last_ns > first_ns) ? last_ns - first_ns : 0;
+    u32 head = 0;
+
+    if (0 == rec_num)
+        return 0;
+
+    cap->push_ns = last_ns;
+    if (IIOCAP_POST == cap->state && last_ns >= cap->post_end_ns)
+        cap->state = IIOCAP_IDLE;
+
+    /* A running capture takes the records as they come */
+    if (IIOCAP_POST == cap->state)
+        return rec_num;
+
+    for (usize i = 0; i < rec_num; i++) {
+        head = (cap->tail + cap->rec_num) % IIOCAP_RING_REC;
+        memcpy(cap->rec + head * HEXDUMP_RECORD_LEN, rec + i * HEXDUMP_RECORD_LEN, HEXDUMP_RECORD_LEN);
+        /* Records between the first and the last one are spread evenly */
+        cap->rec_ns[head] = (1U == rec_num) ? last_ns : first_ns + span * i / (rec_num - 1U);
+
+        if (cap->rec_num < IIOCAP_RING_REC)
+            cap->rec_num++;
+        else
+            cap->tail = (cap->tail + 1U) % IIOCAP_RING_REC;
+    }
+
+    return 0;
+}
+
+bool iiocap_trigger(iiocap_t *cap, u64 now) {
+    u64 pre_ns = (u64)cap->cfg.pre_ms * IIOCAP_NS_PER_MS;
+
+    if (IIOCAP_POST == cap->state && now < cap->post_end_ns)
+        return false;
+
+    while (cap->rec_num > 0 && cap->rec_ns[cap->tail] + pre_ns < now) {
+        cap->tail = (cap->tail + 1U) % IIOCAP_RING_REC;
+        cap->rec_num--;
+    }
+
+    cap->state = IIOCAP_POST;
+    cap->trig_ns = now;
+    cap->post_end_ns = now + (u64)cap->cfg.post_ms * IIOCAP_NS_PER_MS;
+
+    return true;
+}
+
+usize iiocap_drain(iiocap_t *cap, u8 *out, usize rec_max) {
+    usize num = 0;
+
+    while (num < rec_max && cap->rec_num > 0) {
+        memcpy(out + num * HEXDUMP_RECORD_LEN, cap->rec + cap->tail * HEXDUMP_RECORD_LEN, HEXDUMP_RECORD_LEN);
+        cap->tail = (cap->tail + 1U) % IIOCAP_RING_REC;
+        cap->rec_num--;
+        num++;
+    }
+
+    return num;
+}
+
+bool iiocap_checkSlope(iiocap_t *cap, s64 val, u64 ts) {
+    double slope = 0;
+
+    if (0 == cap->cfg.slope)
+        return false;
+
+    /* A timestamp going back is a restarted buffer, the reference starts over */
+    if (!cap->ref_set || ts < cap->ref_ns) {
+        cap->ref_set = true;
+        cap->ref_val = val;
+        cap->ref_ns = ts;
+        return false;
+    }
+
+    if (ts - cap->ref_ns < IIOCAP_SLOPE_SPAN_NS)
+        return false;
+
+    slope = (double)(val - cap->ref_val) * 1e9 / (double)(ts - cap->ref_ns);
+    cap->ref_val = val;
+    cap->ref_ns = ts;
+
+    return (cap->cfg.slope > 0) ? slope >= cap->cfg.slope : slope <= cap->cfg.slope;
+}
+
+void iiocap_free(iiocap_t *cap) {
+    if (NULL == cap)
+        return;
+
+    if (cap->fd >= 0)
+        close(cap->fd);
+    free(cap->rec);
+    free(cap);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+* iio_conv.cpp                                                                                                        *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Conversion of decoded buffer values into the units of the IIO ABI. The type of a scan element, e.g.           *
+*       le:s12/16>>4, gives the shift, the valid bits and the sign. A batch is converted a channel at a time          *
+*       over the interleaved scans, so the terms of a channel are loaded once per batch.                              *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            iioconv_parseType(iioconv_chan_t *chan, const char *type);                                *
+*       void                iioconv_setScale(iioconv_chan_t *chan, double scale, double offset);                      *
+*       usize               iioconv_toSI(const iioconv_t *conv, const s64 *raw, double *si, usize val_num);           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+#include "iio_conv.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define IIOCONV_WORD_BITS   64U
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+/* Valid bits of the element, sign extended or masked. The decoding leaves the storage word as it is. */
+static inline s64 get_bits(const iioconv_chan_t *chan, s64 raw) {
+    u8 pad = IIOCONV_WORD_BITS - chan->realbits;
+    u64 val = (u64)raw >> chan->shift;
+
+    if (0 == pad)
+        return (s64)val;
+
+    return chan->is_signed ? (s64)(val << pad) >> pad : (s64)(val & (~0ULL >> pad));
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t iioconv_parseType(iioconv_chan_t *chan, const char *type) {
+    const char *shift = strstr(type, ">>");
+    char sign = 0;
+    unsigned int realbits = 0, storagebits = 0;
+
+    memset(chan, 0, sizeof(*chan));
+    chan->scale = 1.0;
+
+    /* [be|le]:[s|u]bits/storagebits[Xrepeat][>>shift] */
+    if (3 != sscanf(type, "%*[^:]:%c%u/%u", &sign, &realbits, &storagebits) || 0 == realbits ||
+        realbits > IIOCONV_WORD_BITS) {
+        fprintf(stderr, "ERROR: Unknown scan element type: %s\n", type);
+        return STD_NOT_OK;
+    }
+
+    chan->is_signed = ('s' == sign);
+    chan->realbits = (u8)realbits;
+    if (NULL != shift)
+        chan->shift = (u8)min(atoi(shift + 2), (int)(IIOCONV_WORD_BITS - realbits));
+
+    return STD_OK;
+}
+
+void iioconv_setScale(iioconv_chan_t *chan, double scale, double offset) {
+    chan->scale = scale;
+    chan->offset = offset;
+    chan->bias = offset * scale;
+}
+
+usize iioconv_toSI(const iioconv_t *conv, const s64 *raw, double *si, usize val_num) {
+    const iioconv_chan_t *chan = NULL;
+    usize scan_num = 0, i = 0;
+
+    if (0 == conv->chan_num)
+        return 0;
+
+    scan_num = val_num / conv->chan_num;
+
+    for (u8 c = 0; c < conv->chan_num; c++) {
+        chan = &conv->chan[c];
+        for (i = c; i < scan_num * conv->chan_num; i += conv->chan_num)
+            si[i] = (double)get_bits(chan, raw[i]) * chan->scale + chan->bias;
+    }
+
+    return scan_num * conv->chan_num;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+* iio_scan.cpp                                                                                                        *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Decoding of IIO buffer scans into channel values and parsing of the hexdump log lines back into               *
+*       raw scan records.                                                                                             *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       int                 iioscan_extract(const data_format_t *format, u8 *chan_idx, s64 *dst,                      *
+*                                           const u8 *src, const usize size)                                          *
+*       usize               iioscan_scanSize(const data_format_t *format)                                             *
+*       int                 iioscan_parseHexLine(const char *line, usize len, u8 *record, const char **append,        *
+*                                                usize *append_len)                                                   *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <string.h>
+
+#include "utils.h"
+#include "iio_scan.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define HEXLINE_APPEND_SEP  "| "
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static int hex_val(const char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+static usize get_scan_align(const data_format_t *format) {
+    usize scan_align = 1;
+
+    for (u8 i = 0; i < format->chan_num; i++)
+        scan_align = max(scan_align, (usize)(format->storagebits[i] / BYTE));
+
+    return scan_align;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int iioscan_extract(const data_format_t *format, u8 *chan_idx, s64 *dst, const u8 *src, const usize size) {
+    usize pos = 0, bytes = 0, align = 0, scan_align = 0;
+    int dst_size = 0;
+    u8 chan = 0;
+
+    if (0 == format->chan_num)
+        return 0;
+
+    chan = *chan_idx % format->chan_num;
+    scan_align = get_scan_align(format);
+
+    /**
+     * The data is a continuous stream of scans. IIO aligns every element to its own size and every scan to
+     * its largest element, e.g. the timestamp follows a 16 bit channel after 6 bytes of padding.
+     * Alignments divide HEXDUMP_RECORD_LEN, so the decoding can stop and resume on any record boundary.
+     */
+    for (;;) {
+        bytes = format->storagebits[chan] / BYTE;
+        if (0 == bytes)
+            break;
+        align = (0 == chan) ? scan_align : bytes;
+        pos = (pos + align - 1) / align * align;
+        if (pos + bytes > size)
+            break;
+
+        dst[dst_size++] = merge_bytes(src + pos, format->storagebits[chan]);
+        pos += bytes;
+        chan = (chan + 1) % format->chan_num;
+    }
+
+    /* The channel of the next value, decoding can continue with the following data */
+    *chan_idx = chan;
+
+    return dst_size;
+}
+
+/* Bytes of a scan in the buffer, including the padding of the alignment rules above */
+usize iioscan_scanSize(const data_format_t *format) {
+    usize pos = 0, bytes = 0, scan_align = get_scan_align(format);
+
+    for (u8 i = 0; i < format->chan_num; i++) {
+        bytes = max((usize)(format->storagebits[i] / BYTE), (usize)1);
+        pos = (pos + bytes - 1) / bytes * bytes + bytes;
+    }
+
+    return (pos + scan_align - 1) / scan_align * scan_align;
+}
+
+int iioscan_parseHexLine(const char *line, usize len, u8 *record, const char **append, usize *append_len) {
+    const char *sep = NULL;
+    usize pos = 0;
+    int hi = 0, lo = 0;
+
+    *append = NULL;
+    *append_len = 0;
+
+    for (usize i = 0; i < HEXDUMP_RECORD_LEN; i++) {
+        while (pos < len && ' ' == line[pos])
+            pos++;
+        if (pos + 1 >= len)
+            return -1;
+
+        hi = hex_val(line[pos]);
+        lo = hex_val(line[pos + 1]);
+        if (hi < 0 || lo < 0)
+            return -1;
+        pos += 2;
+
+        /* The logger swaps the bytes of every 16 bit word, see flip_nibbles() */
+        record[i ^ 1] = (u8)(hi << 4 | lo);
+    }
+
+    sep = memchr(line + pos, HEXLINE_APPEND_SEP[0], len - pos);
+    if (NULL != sep && (usize)(sep - line) + 1 < len && HEXLINE_APPEND_SEP[1] == sep[1]) {
+        *append = sep + 2;
+        *append_len = len - (usize)(*append - line);
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
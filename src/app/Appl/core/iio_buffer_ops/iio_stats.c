@@ -0,0 +1,194 @@
+/**********************************************************************************************************************
+* iio_stats.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Windowed statistics of decoded buffer channels. The panes form a ring, the pane being filled replaces         *
+*       the oldest one once a summary was produced, and the summary merges the panes with Chan's formula.             *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       iiostats_t *        iiostats_alloc(const u8 chan_num, const iiostats_cfg_t *cfg);                             *
+*       usize               iiostats_push(iiostats_t *st, const s64 *scan, u64 ts, char *out, usize cap);             *
+*       usize               iiostats_header(const iiostats_t *st, char *out, usize cap);                              *
+*       void                iiostats_free(iiostats_t *st);                                                            *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+#include "iio_stats.h"
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static void acc_reset(iiostats_acc_t *acc) {
+    memset(acc, 0, sizeof(*acc));
+}
+
+static void acc_add(iiostats_acc_t *acc, const s64 val) {
+    double delta = (double)val - acc->mean;
+
+    if (0 == acc->n || val < acc->min)
+        acc->min = val;
+    if (0 == acc->n || val > acc->max)
+        acc->max = val;
+
+    acc->n++;
+    acc->mean += delta / acc->n;
+    acc->m2 += delta * ((double)val - acc->mean);
+}
+
+static void acc_merge(iiostats_acc_t *dst, const iiostats_acc_t *src) {
+    double delta = src->mean - dst->mean;
+    u32 n = dst->n + src->n;
+
+    if (0 == src->n)
+        return;
+    if (0 == dst->n) {
+        *dst = *src;
+        return;
+    }
+
+    dst->min = min(dst->min, src->min);
+    dst->max = max(dst->max, src->max);
+    dst->mean += delta * src->n / n;
+    dst->m2 += src->m2 + delta * delta * ((double)dst->n * src->n / n);
+    dst->n = n;
+}
+
+static usize print_summary(const iiostats_t *st, u64 ts, char *out, usize cap) {
+    iiostats_acc_t win = {0};
+    u8 first = (st->pane_idx + 1U) % st->pane_num;
+    usize len = 0;
+    int ret = 0;
+
+    for (u8 ch = 0; ch < st->chan_num; ch++) {
+        acc_reset(&win);
+        for (u8 p = 0; p < st->pane_num; p++)
+            acc_merge(&win, &st->pane[p][ch]);
+
+        if (0 == ch) {
+            ret = snprintf(out, cap, "%llu,%llu,%u", (unsigned long long)ts,
+                           (unsigned long long)st->pane_ts[first], win.n);
+            if (ret < 0 || (usize)ret >= cap)
+                return 0;
+            len = (usize)ret;
+        }
+
+        ret = snprintf(out + len, cap - len, ",%lld,%lld,%.3f,%.3f", (long long)win.min, (long long)win.max,
+                       win.mean, (win.n > 1U) ? win.m2 / (win.n - 1U) : 0.0);
+        if (ret < 0 || (usize)ret >= cap - len)
+            return 0;
+        len += (usize)ret;
+    }
+
+    if (len + 1U >= cap)
+        return 0;
+    out[len++] = '\n';
+    out[len] = '\0';
+
+    return len;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+iiostats_t *iiostats_alloc(const u8 chan_num, const iiostats_cfg_t *cfg) {
+    iiostats_t *st = NULL;
+    u16 hop = (0 != cfg->hop) ? cfg->hop : cfg->window;
+    u32 pane_num = 0;
+
+    if (0 == cfg->window || 0 == chan_num || chan_num > IIOSTATS_CHAN_MAX)
+        return NULL;
+
+    /* The window is a whole number of hops */
+    hop = min(hop, cfg->window);
+    pane_num = (cfg->window + hop - 1U) / hop;
+    if (pane_num > IIOSTATS_PANE_MAX) {
+        fprintf(stderr, "ERROR: Statistics window of %u scans is cut to %u hops.\n", cfg->window, IIOSTATS_PANE_MAX);
+        pane_num = IIOSTATS_PANE_MAX;
+    }
+
+    st = (iiostats_t *)calloc(1, sizeof(iiostats_t));
+    if (NULL == st)
+        return NULL;
+
+    st->cfg = *cfg;
+    st->cfg.hop = hop;
+    st->cfg.window = (u16)(pane_num * hop);
+    st->chan_num = chan_num;
+    st->pane_num = (u8)pane_num;
+
+    return st;
+}
+
+usize iiostats_push(iiostats_t *st, const s64 *scan, u64 ts, char *out, usize cap) {
+    usize len = 0;
+
+    if (0 == st->pane_fill)
+        st->pane_ts[st->pane_idx] = ts;
+
+    for (u8 ch = 0; ch < st->chan_num; ch++)
+        acc_add(&st->pane[st->pane_idx][ch], scan[ch]);
+
+    if (++st->pane_fill < st->cfg.hop)
+        return 0;
+
+    /* The pane is complete, a summary is due once the window is covered */
+    if (st->pane_done < st->pane_num)
+        st->pane_done++;
+    if (st->pane_done == st->pane_num)
+        len = print_summary(st, ts, out, cap);
+
+    st->pane_idx = (st->pane_idx + 1U) % st->pane_num;
+    st->pane_fill = 0;
+    for (u8 ch = 0; ch < st->chan_num; ch++)
+        acc_reset(&st->pane[st->pane_idx][ch]);
+
+    return len;
+}
+
+usize iiostats_header(const iiostats_t *st, char *out, usize cap) {
+    int ret = snprintf(out, cap, "ts_ns,first_ts_ns,scans");
+    usize len = 0;
+
+    if (ret < 0 || (usize)ret >= cap)
+        return 0;
+    len = (usize)ret;
+
+    for (u8 ch = 0; ch < st->chan_num; ch++) {
+        ret = snprintf(out + len, cap - len, ",c%u_min,c%u_max,c%u_mean,c%u_var", ch, ch, ch, ch);
+        if (ret < 0 || (usize)ret >= cap - len)
+            return 0;
+        len += (usize)ret;
+    }
+
+    if (len + 1U >= cap)
+        return 0;
+    out[len++] = '\n';
+    out[len] = '\0';
+
+    return len;
+}
+
+void iiostats_free(iiostats_t *st) {
+    free(st);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
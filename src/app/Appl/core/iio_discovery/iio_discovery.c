@@ -0,0 +1,289 @@
+/**********************************************************************************************************************
+* iio_discovery.cpp                                                                                                   *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Name based IIO device discovery. /sys/bus/iio/devices is scanned once and every hab device is                 *
+*       matched by its DT label or by the "<iio name>[@<i2c address>]" string generated by the build                  *
+*       system. Resolved paths and opened file descriptors are cached, devices that arrive later are                  *
+*       attached from the uevent handlers through iiodisc_attach().                                                   *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       void                iiodisc_scan(void)                                                                        *
+*       bool                iiodisc_isPresent(const u32 dev_idx)                                                      *
+*       const char *        iiodisc_getSysfsPath(const u32 dev_idx)                                                   *
+*       const char *        iiodisc_getDevfsPath(const u32 dev_idx)                                                   *
+*       int                 iiodisc_getFd(const u32 dev_idx, const iiodisc_fd_t fd_type)                              *
+*       s32                 iiodisc_attach(const char *kobj_name)                                                     *
+*       s32                 iiodisc_detach(const char *kobj_name)                                                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include "utils.h"
+#include "iio_discovery.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define IIO_DEVFS_PATH          "/dev/"
+#define IIO_DEV_NAME_SUBPATH    "name"
+#define IIO_DEV_LABEL_SUBPATH   "label"
+#define IIO_DEV_DATA_AVAIL_SUBPATH "buffer/data_available"
+
+#define IIO_MATCH_ADDR_SEP      '@'
+#define I2C_CLIENT_ADDR_SEP     '-'
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    bool found;
+    char kobj_name[32];
+    char sysfs_path[64];
+    char devfs_path[32];
+    int fd[IIODISC_FD_NUM];
+} iiodisc_dev_t;
+
+typedef struct {
+    char name[32];
+    char label[32];
+    char parent[32];
+} iiodisc_ident_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const char *dev_names[] = HAB_DEV_NAME;
+static const char *iio_match[] = HAB_DEV_IIO_MATCH;
+
+static iiodisc_dev_t disc_list[ARRAY_SIZE(iio_match)];
+static bool disc_scanned;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+static void read_ident(const char *kobj_name, iiodisc_ident_t *ident);
+static bool ident_matches(const u32 dev_idx, const iiodisc_ident_t *ident);
+static void close_fds(iiodisc_dev_t *dev);
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static void read_attr(const char *kobj_name, const char *attr, char *buff, usize size) {
+    int fd = -1;
+    ssize_t len = 0;
+    char path_buff[128] = {0};
+
+    memset(buff, 0, size);
+    snprintf(path_buff, sizeof(path_buff), "%s%s/%s", IIO_SYSFS_PATH, kobj_name, attr);
+
+    fd = open(path_buff, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    len = read(fd, buff, size - 1);
+    close(fd);
+
+    if (len > 0)
+        CROP_NEWLINE(buff, strlen(buff));
+}
+
+static void read_ident(const char *kobj_name, iiodisc_ident_t *ident) {
+    char path_buff[128] = {0};
+    char real_path[PATH_MAX] = {0};
+    char *sep = NULL;
+
+    memset(ident, 0, sizeof(*ident));
+    read_attr(kobj_name, IIO_DEV_NAME_SUBPATH, ident->name, sizeof(ident->name));
+    read_attr(kobj_name, IIO_DEV_LABEL_SUBPATH, ident->label, sizeof(ident->label));
+
+    /* The bus device owning the IIO device, e.g. "1-0048" for an I2C client */
+    snprintf(path_buff, sizeof(path_buff), "%s%s", IIO_SYSFS_PATH, kobj_name);
+    if (NULL == realpath(path_buff, real_path))
+        return;
+
+    sep = strrchr(real_path, '/');
+    if (NULL == sep)
+        return;
+    *sep = '\0';
+
+    sep = strrchr(real_path, '/');
+    /* Bus device names are short, a longer component is cut to the size of the field */
+    snprintf(ident->parent, sizeof(ident->parent), "%.*s", (int)sizeof(ident->parent) - 1,
+             (NULL != sep) ? sep + 1 : real_path);
+}
+
+static bool ident_matches(const u32 dev_idx, const iiodisc_ident_t *ident) {
+    char base[32] = {0};
+    const char *addr = NULL;
+    const char *client_addr = NULL;
+    usize base_len = 0;
+
+    if ('\0' == iio_match[dev_idx][0])
+        return false;
+
+    if ('\0' != ident->label[0] && 0 == str_compare(ident->label, dev_names[dev_idx]))
+        return true;
+
+    addr = strchr(iio_match[dev_idx], IIO_MATCH_ADDR_SEP);
+    base_len = (NULL != addr) ? (usize)(addr - iio_match[dev_idx]) : strlen(iio_match[dev_idx]);
+    snprintf(base, min(sizeof(base), base_len + 1), "%s", iio_match[dev_idx]);
+
+    if (0 != str_compare(base, ident->name))
+        return false;
+
+    if (NULL == addr)
+        return true;
+
+    client_addr = strrchr(ident->parent, I2C_CLIENT_ADDR_SEP);
+    if (NULL == client_addr)
+        return false;
+
+    return strtoul(client_addr + 1, NULL, 16) == strtoul(addr + 1, NULL, 16);
+}
+
+static void close_fds(iiodisc_dev_t *dev) {
+    for (int i = 0; i < IIODISC_FD_NUM; i++) {
+        if (dev->fd[i] >= 0)
+            close(dev->fd[i]);
+        dev->fd[i] = -1;
+    }
+}
+
+static void ensure_scanned(void) {
+    if (!disc_scanned)
+        iiodisc_scan();
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+void iiodisc_scan(void) {
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+
+    if (!disc_scanned) {
+        for (usize i = 0; i < ARRAY_SIZE(disc_list); i++)
+            memset(disc_list[i].fd, -1, sizeof(disc_list[i].fd));
+        disc_scanned = true;
+    }
+
+    dir = opendir(IIO_SYSFS_PATH);
+    if (NULL == dir) {
+        fprintf(stderr, "ERROR: Could not open %s\n", IIO_SYSFS_PATH);
+        return;
+    }
+
+    while (NULL != (entry = readdir(dir))) {
+        if (0 == strncmp(entry->d_name, IIO_DEV_KOBJ_BASE, sizeof(IIO_DEV_KOBJ_BASE) - 1))
+            (void)iiodisc_attach(entry->d_name);
+    }
+
+    closedir(dir);
+}
+
+bool iiodisc_isPresent(const u32 dev_idx) {
+    ensure_scanned();
+
+    return (dev_idx < ARRAY_SIZE(disc_list)) && disc_list[dev_idx].found;
+}
+
+const char *iiodisc_getSysfsPath(const u32 dev_idx) {
+    return iiodisc_isPresent(dev_idx) ? disc_list[dev_idx].sysfs_path : NULL;
+}
+
+const char *iiodisc_getDevfsPath(const u32 dev_idx) {
+    return iiodisc_isPresent(dev_idx) ? disc_list[dev_idx].devfs_path : NULL;
+}
+
+int iiodisc_getFd(const u32 dev_idx, const iiodisc_fd_t fd_type) {
+    iiodisc_dev_t *dev = NULL;
+    char path_buff[128] = {0};
+
+    if (!iiodisc_isPresent(dev_idx) || fd_type >= IIODISC_FD_NUM)
+        return -1;
+
+    dev = &disc_list[dev_idx];
+    if (dev->fd[fd_type] >= 0)
+        return dev->fd[fd_type];
+
+    switch (fd_type) {
+    case IIODISC_FD_BUFF:
+        dev->fd[fd_type] = open(dev->devfs_path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        break;
+    case IIODISC_FD_DATA_AVAIL:
+        snprintf(path_buff, sizeof(path_buff), "%s%s", dev->sysfs_path, IIO_DEV_DATA_AVAIL_SUBPATH);
+        dev->fd[fd_type] = open(path_buff, O_RDONLY | O_CLOEXEC);
+        break;
+    default:
+        break;
+    }
+
+    if (dev->fd[fd_type] < 0)
+        fprintf(stderr, "ERROR: Could not open descriptor %d of %s\n", fd_type, dev->kobj_name);
+
+    return dev->fd[fd_type];
+}
+
+s32 iiodisc_attach(const char *kobj_name) {
+    iiodisc_ident_t ident = {0};
+
+    ensure_scanned();
+
+    for (usize i = 0; i < ARRAY_SIZE(disc_list); i++) {
+        if (disc_list[i].found && 0 == str_compare(kobj_name, disc_list[i].kobj_name))
+            return (s32)i;
+    }
+
+    read_ident(kobj_name, &ident);
+
+    for (usize i = 0; i < ARRAY_SIZE(disc_list); i++) {
+        if (disc_list[i].found || !ident_matches(i, &ident))
+            continue;
+
+        disc_list[i].found = true;
+        snprintf(disc_list[i].kobj_name, sizeof(disc_list[i].kobj_name), "%s", kobj_name);
+        snprintf(disc_list[i].sysfs_path, sizeof(disc_list[i].sysfs_path), "%s%s/", IIO_SYSFS_PATH, kobj_name);
+        snprintf(disc_list[i].devfs_path, sizeof(disc_list[i].devfs_path), "%s%s", IIO_DEVFS_PATH, kobj_name);
+
+        printf("INFO: %s resolved to %s\n", dev_names[i], kobj_name);
+        return (s32)i;
+    }
+
+    return -1;
+}
+
+s32 iiodisc_detach(const char *kobj_name) {
+    for (usize i = 0; i < ARRAY_SIZE(disc_list); i++) {
+        if (disc_list[i].found && 0 == str_compare(kobj_name, disc_list[i].kobj_name)) {
+            close_fds(&disc_list[i]);
+            disc_list[i].found = false;
+            return (s32)i;
+        }
+    }
+
+    return -1;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
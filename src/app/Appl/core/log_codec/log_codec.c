@@ -0,0 +1,337 @@
+/**********************************************************************************************************************
+* log_codec.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Columnar delta + zigzag + bit-packing codec for slowly changing sensor channels. Scans are split              *
+*       into per channel columns, a block is emitted once LOGCODEC_BLOCK_REC scans are collected. Each column         *
+*       takes the differences to the previous sample or to a line, whichever packs into fewer bits.                               *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       logcodec_t *        logcodec_alloc(const data_format_t *df, const u16 sign_mask)                              *
+*       usize               logcodec_push(logcodec_t *codec, const u8 *scan, u8 *out, usize size)                     *
+*       usize               logcodec_flush(logcodec_t *codec, u8 *out, usize size)                                    *
+*       stdret_t            logcodec_decode(const u8 *src, usize size, usize *used, s64 *dst, u8 *chan, u8 *rec)      *
+*       void                logcodec_free(logcodec_t *codec)                                                          *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "utils.h"
+#include "log_codec.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define LOGCODEC_WORD_BITS  64U
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+static s64 read_le(const u8 *bytes, const u8 bits, const bool is_signed);
+static usize put_varint(u8 *out, u64 val);
+static usize get_varint(const u8 *src, usize size, u64 *val);
+static usize put_bits(u8 *out, const u64 *vals, usize num, u8 width);
+static stdret_t get_bits(const u8 *src, usize size, u64 *vals, usize num, u8 width);
+static usize encode_column(const s64 *col, u8 rec_num, u8 *out);
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static s64 read_le(const u8 *bytes, const u8 bits, const bool is_signed) {
+    u64 val = 0;
+
+    for (u8 i = 0; i < bits / BYTE; i++)
+        val |= (u64)bytes[i] << (i * BYTE);
+
+    /* Only a signed storage word is sign extended, unsigned channels keep their top bit as a value bit */
+    if (is_signed && bits < LOGCODEC_WORD_BITS && (val & (1ULL << (bits - 1))))
+        val |= ~0ULL << bits;
+
+    return (s64)val;
+}
+
+static inline u64 zigzag(const s64 val) {
+    return ((u64)val << 1) ^ (u64)(val >> 63);
+}
+
+static inline s64 unzigzag(const u64 val) {
+    return (s64)(val >> 1) ^ -(s64)(val & 1);
+}
+
+/* Differences wrap like the storage words do, a full range 64 bit channel still round trips */
+static inline s64 diff(const s64 a, const s64 b) {
+    return (s64)((u64)a - (u64)b);
+}
+
+static inline s64 sum(const s64 a, const s64 b) {
+    return (s64)((u64)a + (u64)b);
+}
+
+static inline u8 bit_width(const u64 val) {
+    return (0 == val) ? 0 : (u8)(LOGCODEC_WORD_BITS - (u8)__builtin_clzll(val));
+}
+
+static usize put_varint(u8 *out, u64 val) {
+    usize len = 0;
+
+    while (val >= 0x80) {
+        out[len++] = (u8)(val | 0x80);
+        val >>= 7;
+    }
+    out[len++] = (u8)val;
+
+    return len;
+}
+
+/* Returns the length of the varint, 0 when it is damaged or cut */
+static usize get_varint(const u8 *src, usize size, u64 *val) {
+    *val = 0;
+
+    for (usize i = 0; i < size && i < LOGCODEC_VARINT_MAX; i++) {
+        *val |= (u64)(src[i] & 0x7F) << (7 * i);
+        if (0 == (src[i] & 0x80))
+            return i + 1;
+    }
+
+    return 0;
+}
+
+static usize put_bits(u8 *out, const u64 *vals, usize num, u8 width) {
+    usize len = (num * width + BYTE - 1) / BYTE;
+    usize bit = 0;
+    u8 take = 0;
+
+    memset(out, 0, len);
+
+    for (usize i = 0; i < num; i++) {
+        for (u8 j = 0; j < width; j += take, bit += take) {
+            take = (u8)min((usize)(width - j), (usize)(BYTE - bit % BYTE));
+            out[bit / BYTE] |= (u8)(((vals[i] >> j) & ((1U << take) - 1)) << (bit % BYTE));
+        }
+    }
+
+    return len;
+}
+
+static stdret_t get_bits(const u8 *src, usize size, u64 *vals, usize num, u8 width) {
+    usize bit = 0;
+    u8 take = 0;
+
+    if (size < (num * width + BYTE - 1) / BYTE)
+        return STD_NOT_OK;
+
+    for (usize i = 0; i < num; i++) {
+        vals[i] = 0;
+        for (u8 j = 0; j < width; j += take, bit += take) {
+            take = (u8)min((usize)(width - j), (usize)(BYTE - bit % BYTE));
+            vals[i] |= (u64)((src[bit / BYTE] >> (bit % BYTE)) & ((1U << take) - 1)) << j;
+        }
+    }
+
+    return STD_OK;
+}
+
+static usize encode_column(const s64 *col, u8 rec_num, u8 *out) {
+    s64 res[2][LOGCODEC_BLOCK_REC] = {0};
+    s64 lo[2] = {0}, hi[2] = {0};
+    u64 packed[LOGCODEC_BLOCK_REC] = {0};
+    u8 tmp[LOGCODEC_VARINT_MAX] = {0};
+    usize len = 1, bits[2] = {0};
+    s64 step = 0;
+    u8 line = 0, width[2] = {0};
+
+    if (rec_num > 1)
+        step = diff(col[rec_num - 1], col[0]) / (rec_num - 1);
+
+    /* res[0] - differences to the previous sample, res[1] - to the line through the first and the last one */
+    for (u8 i = 1; i < rec_num; i++) {
+        res[0][i - 1] = diff(col[i], col[i - 1]);
+        res[1][i - 1] = diff(col[i], sum(col[0], (s64)((u64)step * i)));
+        for (u8 j = 0; j < 2; j++) {
+            lo[j] = (1 == i) ? res[j][0] : min(lo[j], res[j][i - 1]);
+            hi[j] = (1 == i) ? res[j][0] : max(hi[j], res[j][i - 1]);
+        }
+    }
+
+    /* Residuals are stored above their minimum, the line pays for its step */
+    for (u8 j = 0; j < 2; j++) {
+        width[j] = bit_width((u64)hi[j] - (u64)lo[j]);
+        bits[j] = (usize)width[j] * (rec_num - 1U) + put_varint(tmp, zigzag(lo[j])) * BYTE;
+    }
+    bits[1] += put_varint(tmp, zigzag(step)) * BYTE;
+    line = (bits[1] < bits[0]) ? 1 : 0;
+
+    for (u8 i = 1; i < rec_num; i++)
+        packed[i - 1] = (u64)res[line][i - 1] - (u64)lo[line];
+
+    out[0] = (u8)(width[line] | ((0 != line) ? LOGCODEC_MODE_LINE : 0));
+    len += put_varint(out + len, zigzag(col[0]));
+    if (0 != line)
+        len += put_varint(out + len, zigzag(step));
+    len += put_varint(out + len, zigzag(lo[line]));
+
+    return len + put_bits(out + len, packed, rec_num - 1U, width[line]);
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+logcodec_t *logcodec_alloc(const data_format_t *df, const u16 sign_mask) {
+    logcodec_t *codec = NULL;
+    usize pos = 0;
+    u8 bytes = 0;
+
+    /* A scan the columns can not hold is rejected, dropping channels would shift every value after them */
+    if (0 == df->chan_num || df->chan_num > LOGCODEC_CHAN_MAX) {
+        fprintf(stderr, "ERROR: Scans of %u channels can not be encoded.\n", df->chan_num);
+        return NULL;
+    }
+
+    for (u8 i = 0; i < df->chan_num; i++) {
+        if (0 == df->storagebits[i] || 0 != df->storagebits[i] % BYTE || df->storagebits[i] > LOGCODEC_WORD_BITS) {
+            fprintf(stderr, "ERROR: Channel %u of %u bits can not be encoded.\n", i, df->storagebits[i]);
+            return NULL;
+        }
+    }
+
+    codec = (logcodec_t *)calloc(1, sizeof(logcodec_t));
+    if (NULL == codec) {
+        fprintf(stderr, "ERROR: Error allocating log codec.\n");
+        return NULL;
+    }
+
+    /* Every element is aligned to its own size, the same rules iioscan_extract() decodes with */
+    for (u8 i = 0; i < df->chan_num; i++) {
+        bytes = df->storagebits[i] / BYTE;
+        pos = (pos + bytes - 1) / bytes * bytes;
+        codec->offset[i] = (u8)pos;
+        codec->storagebits[i] = df->storagebits[i];
+        pos += bytes;
+    }
+
+    codec->chan_num = df->chan_num;
+    codec->scan_len = (u8)iioscan_scanSize(df);
+    codec->sign_mask = sign_mask;
+    codec->ts_en = df->ts_en;
+
+    return codec;
+}
+
+usize logcodec_push(logcodec_t *codec, const u8 *scan, u8 *out, usize size) {
+    for (u8 i = 0; i < codec->chan_num; i++)
+        codec->col[i][codec->rec_num] = read_le(scan + codec->offset[i], codec->storagebits[i],
+                                                0 != (codec->sign_mask & (1U << i)));
+
+    if (++codec->rec_num < LOGCODEC_BLOCK_REC)
+        return 0;
+
+    return logcodec_flush(codec, out, size);
+}
+
+usize logcodec_flush(logcodec_t *codec, u8 *out, usize size) {
+    usize len = LOGCODEC_HDR_LEN;
+    usize payload_len = 0;
+
+    if (0 == codec->rec_num)
+        return 0;
+
+    if (size < LOGCODEC_BLOCK_MAX) {
+        fprintf(stderr, "ERROR: Log codec output buffer is too small.\n");
+        codec->rec_num = 0;
+        return 0;
+    }
+
+    for (u8 i = 0; i < codec->chan_num; i++)
+        len += encode_column(codec->col[i], codec->rec_num, out + len);
+
+    payload_len = len - LOGCODEC_HDR_LEN;
+    out[0] = LOGCODEC_MAGIC;
+    out[1] = (u8)(codec->chan_num | (codec->ts_en ? LOGCODEC_CHAN_TS : 0));
+    out[2] = codec->rec_num;
+    out[3] = (u8)payload_len;
+    out[4] = (u8)(payload_len >> BYTE);
+
+    codec->rec_num = 0;
+
+    return len;
+}
+
+stdret_t logcodec_decode(const u8 *src, usize size, usize *used, s64 *dst, u8 *chan_num, u8 *rec_num) {
+    u64 packed[LOGCODEC_BLOCK_REC] = {0};
+    usize end = 0, pos = LOGCODEC_HDR_LEN;
+    usize len = 0;
+    u64 val[3] = {0};
+    s64 prev = 0;
+    u8 mode = 0, width = 0, field_num = 0;
+
+    if (size < LOGCODEC_HDR_LEN || LOGCODEC_MAGIC != src[0])
+        return STD_NOT_OK;
+
+    *chan_num = src[1] & (u8)~LOGCODEC_CHAN_TS;
+    *rec_num = src[2];
+    end = LOGCODEC_HDR_LEN + (src[3] | ((usize)src[4] << BYTE));
+
+    if (*chan_num > LOGCODEC_CHAN_MAX || 0 == *rec_num || *rec_num > LOGCODEC_BLOCK_REC || size < end)
+        return STD_NOT_OK;
+
+    /* Output is row major: dst[rec * chan_num + chan] */
+    for (u8 i = 0; i < *chan_num; i++) {
+        if (pos >= end)
+            return STD_NOT_OK;
+        mode = src[pos++];
+        width = mode & LOGCODEC_MODE_WIDTH;
+        if (width > LOGCODEC_WORD_BITS)
+            return STD_NOT_OK;
+
+        /* First value, the step of a line and the minimum of the residuals */
+        field_num = (0 != (mode & LOGCODEC_MODE_LINE)) ? 3 : 2;
+        for (u8 j = 0; j < field_num; j++) {
+            len = get_varint(src + pos, end - pos, &val[j]);
+            if (0 == len)
+                return STD_NOT_OK;
+            pos += len;
+        }
+        if (2 == field_num)
+            val[2] = val[1];
+
+        if (STD_NOT_OK == get_bits(src + pos, end - pos, packed, *rec_num - 1U, width))
+            return STD_NOT_OK;
+        pos += ((*rec_num - 1U) * width + BYTE - 1) / BYTE;
+
+        prev = unzigzag(val[0]);
+        dst[i] = prev;
+        for (u8 j = 1; j < *rec_num; j++) {
+            if (0 != (mode & LOGCODEC_MODE_LINE))
+                prev = sum(unzigzag(val[0]), (s64)((u64)unzigzag(val[1]) * j));
+            prev = sum(prev, sum(unzigzag(val[2]), (s64)packed[j - 1]));
+            dst[j * *chan_num + i] = prev;
+        }
+    }
+
+    *used = end;
+
+    return STD_OK;
+}
+
+void logcodec_free(logcodec_t *codec) {
+    free(codec);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
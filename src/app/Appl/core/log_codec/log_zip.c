@@ -0,0 +1,252 @@
+/**********************************************************************************************************************
+* log_zip.cpp                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Log compression stage. The uv loop collects the data of a log into a block and queues the sealed block         *
+*       to a single worker thread, which encodes it and owns every write and flush of the log from then on.           *
+*       The worker falls back to stored blocks while LOGZIP_BACKOFF_DEPTH blocks wait in the queue or while it        *
+*       used more than HAB_ZIP_CPU_PCT of a core in the current one second window. The loop only waits for the        *
+*       worker when the whole queue is taken, which the stored blocks quickly resolve.                                *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       logzip_t *          logzip_open(storage_t *store);                                                            *
+*       stdret_t            logzip_write(logzip_t *zip, const void *buff, usize size);                                *
+*       stdret_t            logzip_flush(logzip_t *zip, const bool force);                                            *
+*       void                logzip_close(logzip_t *zip);                                                              *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "utils.h"
+#include "log_zip.h"
+#include "storage_budget.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define LOGZIP_CPU_WINDOW_MS  1000U
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    logzip_t *zip;
+    u8 *data;
+    usize len;
+    bool flush;
+    bool close;
+} zip_job_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static zip_job_t job_queue[LOGZIP_QUEUE_LEN];
+static usize job_head;
+static usize job_cnt;
+
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_free = PTHREAD_COND_INITIALIZER;
+static pthread_once_t worker_once = PTHREAD_ONCE_INIT;
+static bool worker_running;
+
+static u8 enc_out[LOGZIP_BLOCK_MAX];
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 clock_ms(const clockid_t clk) {
+    struct timespec ts = {0};
+
+    clock_gettime(clk, &ts);
+
+    return (u64)ts.tv_sec * 1000U + (u64)ts.tv_nsec / MICRO;
+}
+
+/* True while the worker is within its CPU share of the current window */
+static bool cpu_available(void) {
+    static u64 wall_start, cpu_start;
+    u64 wall = clock_ms(CLOCK_MONOTONIC);
+    u64 cpu = clock_ms(CLOCK_THREAD_CPUTIME_ID);
+
+    if (wall - wall_start >= LOGZIP_CPU_WINDOW_MS) {
+        wall_start = wall;
+        cpu_start = cpu;
+        return true;
+    }
+
+    return (cpu - cpu_start) * 100U <= (u64)HAB_ZIP_CPU_PCT * LOGZIP_CPU_WINDOW_MS;
+}
+
+static void run_job(const zip_job_t *job, const bool backoff) {
+    usize len = 0;
+
+    if (NULL != job->data) {
+        len = logzip_encodeBlock(job->data, job->len, enc_out, sizeof(enc_out),
+                                 (backoff || !cpu_available()) ? LOGZIP_STORED : HAB_ZIP_METHOD, HAB_ZIP_LEVEL);
+        if (STD_NOT_OK == storage_write(job->zip->store, enc_out, len))
+            fprintf(stderr, "ERROR: Compressed block of %s is lost.\n", job->zip->store->path);
+        budget_account(BUDGET_SENSOR, len);
+        free(job->data);
+    }
+
+    if (job->flush || job->close)
+        (void)storage_flush(job->zip->store);
+
+    if (job->close) {
+        storage_close(job->zip->store);
+        free(job->zip->blk);
+        free(job->zip);
+    }
+}
+
+static void *worker(void *arg) {
+    zip_job_t job = {0};
+    bool backoff = false;
+
+    (void)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&job_lock);
+        while (0 == job_cnt)
+            pthread_cond_wait(&job_ready, &job_lock);
+
+        job = job_queue[job_head];
+        job_head = (job_head + 1U) % LOGZIP_QUEUE_LEN;
+        backoff = (--job_cnt >= LOGZIP_BACKOFF_DEPTH);
+        pthread_cond_signal(&job_free);
+        pthread_mutex_unlock(&job_lock);
+
+        run_job(&job, backoff);
+    }
+
+    return NULL;
+}
+
+static void start_worker(void) {
+    pthread_t tid;
+
+    worker_running = (0 == pthread_create(&tid, NULL, worker, NULL));
+    if (worker_running)
+        pthread_detach(tid);
+    else
+        fprintf(stderr, "ERROR: Could not start the log compression worker.\n");
+}
+
+static void enqueue(const zip_job_t *job) {
+    /* Without a worker the block is stored by the caller */
+    if (!worker_running) {
+        run_job(job, true);
+        return;
+    }
+
+    pthread_mutex_lock(&job_lock);
+    while (LOGZIP_QUEUE_LEN == job_cnt)
+        pthread_cond_wait(&job_free, &job_lock);
+
+    job_queue[(job_head + job_cnt++) % LOGZIP_QUEUE_LEN] = *job;
+    pthread_cond_signal(&job_ready);
+    pthread_mutex_unlock(&job_lock);
+}
+
+/* Hands the collected block to the worker, the zip gets a fresh one */
+static stdret_t seal(logzip_t *zip, const bool flush, const bool close) {
+    zip_job_t job = {zip, NULL, 0, flush, close};
+
+    if (0 != zip->blk_used) {
+        job.data = zip->blk;
+        job.len = zip->blk_used;
+        zip->blk = (close) ? NULL : (u8 *)malloc(LOGZIP_BLOCK_SIZE);
+        zip->blk_used = 0;
+    }
+
+    enqueue(&job);
+
+    return (close || NULL != zip->blk) ? STD_OK : STD_NOT_OK;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+logzip_t *logzip_open(storage_t *store) {
+    logzip_t *zip = NULL;
+
+    if (NULL == store)
+        return NULL;
+
+    pthread_once(&worker_once, start_worker);
+
+    zip = (logzip_t *)calloc(1, sizeof(logzip_t));
+    if (NULL == zip)
+        return NULL;
+
+    zip->store = store;
+    zip->blk = (u8 *)malloc(LOGZIP_BLOCK_SIZE);
+    if (NULL == zip->blk) {
+        free(zip);
+        return NULL;
+    }
+
+    return zip;
+}
+
+stdret_t logzip_write(logzip_t *zip, const void *buff, usize size) {
+    const u8 *src = (const u8 *)buff;
+    usize len = 0;
+
+    if (NULL == zip->blk)
+        return STD_NOT_OK;
+
+    while (size > 0) {
+        if (0 == zip->blk_used)
+            zip->blk_ms = clock_ms(CLOCK_MONOTONIC);
+
+        len = min(size, LOGZIP_BLOCK_SIZE - zip->blk_used);
+        memcpy(zip->blk + zip->blk_used, src, len);
+        zip->blk_used += len;
+        src += len;
+        size -= len;
+
+        if (LOGZIP_BLOCK_SIZE == zip->blk_used && STD_NOT_OK == seal(zip, false, false))
+            return STD_NOT_OK;
+    }
+
+    return STD_OK;
+}
+
+stdret_t logzip_flush(logzip_t *zip, const bool force) {
+    if (0 == zip->blk_used)
+        return STD_OK;
+
+    /* Small blocks compress poorly, a partial block waits up to LOGZIP_FLUSH_MS for more data */
+    if (!force && clock_ms(CLOCK_MONOTONIC) - zip->blk_ms < LOGZIP_FLUSH_MS)
+        return STD_OK;
+
+    return seal(zip, true, false);
+}
+
+void logzip_close(logzip_t *zip) {
+    if (NULL != zip)
+        (void)seal(zip, true, true);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,147 @@
+/**********************************************************************************************************************
+* log_zip_block.cpp                                                                                                   *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Block encoding of the log compression stage, shared by hab_master and the post-flight tools.                  *
+*       LZ4 blocks are written with liblz4, level 1 takes its fast compressor and higher levels LZ4HC. zstd           *
+*       is used when hab_master is built with ZIP_METHOD_ZSTD.                                                        *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       usize               logzip_encodeBlock(const u8 *src, usize size, u8 *dst, usize cap, u8 method, u8 level);   *
+*       stdret_t            logzip_decodeBlock(const u8 *src, usize size, u8 *dst, usize cap, usize *raw_len);       *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <string.h>
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include "utils.h"
+#include "log_zip.h"
+
+/* HAB_ZIP_METHOD comes from common.mak as a plain number, ZIP_METHOD_ZSTD is 2 */
+#if defined(HAB_ZIP_METHOD) && (2 == HAB_ZIP_METHOD)
+# define LOGZIP_HAVE_ZSTD
+# include <zstd.h>
+#endif
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static usize lz4_compress(const u8 *src, usize size, u8 *dst, usize cap, u8 level) {
+    int len = 0;
+
+    if (level <= 1)
+        len = LZ4_compress_default((const char *)src, (char *)dst, (int)size, (int)cap);
+    else
+        len = LZ4_compress_HC((const char *)src, (char *)dst, (int)size, (int)cap, level);
+
+    return (len > 0) ? (usize)len : 0;
+}
+
+static stdret_t lz4_decompress(const u8 *src, usize size, u8 *dst, usize cap, usize *out_len) {
+    int len = LZ4_decompress_safe((const char *)src, (char *)dst, (int)size, (int)cap);
+
+    if (len < 0)
+        return STD_NOT_OK;
+
+    *out_len = (usize)len;
+
+    return STD_OK;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+usize logzip_encodeBlock(const u8 *src, usize size, u8 *dst, usize cap, u8 method, u8 level) {
+    logzip_hdr_t *hdr = (logzip_hdr_t *)dst;
+    usize len = 0;
+
+    if (cap < sizeof(*hdr) + size)
+        return 0;
+
+    /* A compressed payload has to be smaller than the data, the stored block is used otherwise */
+    switch (method) {
+    case LOGZIP_LZ4:
+        len = lz4_compress(src, size, dst + sizeof(*hdr), size - 1U, level);
+        break;
+#ifdef LOGZIP_HAVE_ZSTD
+    case LOGZIP_ZSTD:
+        len = ZSTD_compress(dst + sizeof(*hdr), size - 1U, src, size, level);
+        if (ZSTD_isError(len))
+            len = 0;
+        break;
+#endif
+    default:
+        break;
+    }
+
+    if (0 == len || len >= size) {
+        method = LOGZIP_STORED;
+        len = size;
+        memcpy(dst + sizeof(*hdr), src, size);
+    }
+
+    hdr->magic   = LOGZIP_MAGIC;
+    hdr->method  = method;
+    hdr->rsvd    = 0;
+    hdr->raw_len = (u32)size;
+
+    return sizeof(*hdr) + len;
+}
+
+stdret_t logzip_decodeBlock(const u8 *src, usize size, u8 *dst, usize cap, usize *raw_len) {
+    const logzip_hdr_t *hdr = (const logzip_hdr_t *)src;
+    stdret_t ret = STD_NOT_OK;
+    usize len = 0;
+
+    if (size < sizeof(*hdr) || LOGZIP_MAGIC != hdr->magic || hdr->raw_len > cap)
+        return STD_NOT_OK;
+
+    src += sizeof(*hdr);
+    size -= sizeof(*hdr);
+
+    switch (hdr->method) {
+    case LOGZIP_STORED:
+        len = size;
+        ret = (size <= cap) ? STD_OK : STD_NOT_OK;
+        if (STD_OK == ret)
+            memcpy(dst, src, size);
+        break;
+    case LOGZIP_LZ4:
+        ret = lz4_decompress(src, size, dst, cap, &len);
+        break;
+#ifdef LOGZIP_HAVE_ZSTD
+    case LOGZIP_ZSTD:
+        len = ZSTD_decompress(dst, cap, src, size);
+        ret = ZSTD_isError(len) ? STD_NOT_OK : STD_OK;
+        break;
+#endif
+    default:
+        fprintf(stderr, "ERROR: Block compressed with unsupported method %u\n", hdr->method);
+        break;
+    }
+
+    if (STD_OK == ret && len != hdr->raw_len)
+        ret = STD_NOT_OK;
+
+    *raw_len = len;
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
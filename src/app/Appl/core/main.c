@@ -1,7 +1,14 @@
 #include <stdio.h>
 #include "hab.h"
+#include "utils.h"
+
+#define HAB_ARG_BOOT "--boot"
+
+int main(int argc, char **argv) {
+    /* Boot mode loads the kernel side itself and starts every device as soon as it appears */
+    if (argc > 1 && 0 == str_compare(argv[1], HAB_ARG_BOOT))
+        return hab_boot();
 
-int main(void) {
     hab_init();
     
     hab_run();
@@ -0,0 +1,627 @@
+/**********************************************************************************************************************
+* storage.cpp                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Log storage backends. In the stream mode a log stays open in append mode. In the mmap mode every              *
+*       segment is allocated up front and mapped, so the steady state write is a memcpy without any block             *
+*       allocation. Dirty pages are synced at most once per STORAGE_MMAP_FLUSH_MS, a segment is trimmed to its        *
+*       used size when it is rotated or the log is closed.                                                            *
+*       In the direct mode data is collected in an erase block sized, aligned buffer and submitted with               *
+*       O_DIRECT. A partially filled block is written zero padded to STORAGE_DIRECT_ALIGN at most once per            *
+*       STORAGE_DIRECT_FLUSH_MS, the padding is rewritten by later data and trimmed when the log is closed.           *
+*       Framed logs are only ever torn at their tail. The tail scan walks the frame headers, then checks              *
+*       the CRC of the last frames of the chain, so a restart costs O(frame count) header reads.                      *
+*       The sidecar index is appended every STORAGE_IDX_EVERY writes and searched with a binary search.              *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       storage_t *         storage_open(const char *path, const bool framed)                                         *
+*       stdret_t            storage_write(storage_t *store, const void *buff, usize size)                             *
+*       stdret_t            storage_flush(storage_t *store)                                                           *
+*       void                storage_close(storage_t *store)                                                           *
+*       u32                 storage_frameCrc(const storage_frame_t *frame, const void *payload)                       *
+*       stdret_t            storage_seek(const char *path, u32 run, u64 ts_ms, bool upper, storage_idx_t *pos)        *
+*       void                storage_getFilePath(const char *path, const u32 seg_seq, char *buff, usize size)          *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "utils.h"
+#include "crc32c.h"
+#include "hab_clock.h"
+#include "storage.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define STORAGE_FILE_MODE   0644
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+static s32 find_last_seq(const char *path);
+static u64 scan_tail(int fd, u32 *next_seq);
+static stdret_t open_segment(storage_t *store, const bool resume);
+static void close_segment(storage_t *store);
+static stdret_t open_direct(storage_t *store, const bool resume);
+static stdret_t sync_block(storage_t *store);
+static stdret_t write_direct(storage_t *store, const u8 *buff, usize size);
+static void close_direct(storage_t *store);
+static stdret_t rotate_segment(storage_t *store);
+static stdret_t write_raw(storage_t *store, const void *buff, usize size);
+static void open_index(storage_t *store);
+static void write_index(storage_t *store);
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static s32 find_last_seq(const char *path) {
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    char dir_buff[64] = {0};
+    char base_buff[64] = {0};
+    const char *base = NULL;
+    usize base_len = 0;
+    u32 seq = 0;
+    s32 last = -1;
+
+    snprintf(dir_buff, sizeof(dir_buff), "%s", path);
+    snprintf(base_buff, sizeof(base_buff), "%s", path);
+    base = basename(base_buff);
+    base_len = strlen(base);
+
+    dir = opendir(dirname(dir_buff));
+    if (NULL == dir)
+        return -1;
+
+    while (NULL != (entry = readdir(dir))) {
+        if (0 != strncmp(entry->d_name, base, base_len) || '.' != entry->d_name[base_len])
+            continue;
+
+        if (1 == sscanf(entry->d_name + base_len + 1, "%u", &seq) && (s32)seq > last)
+            last = (s32)seq;
+    }
+
+    closedir(dir);
+
+    return last;
+}
+
+static bool read_frame(int fd, u64 off, u64 size, storage_frame_t *frame) {
+    if (off + sizeof(*frame) > size || sizeof(*frame) != pread(fd, frame, sizeof(*frame), (off_t)off))
+        return false;
+
+    return STORAGE_FRAME_MAGIC == frame->magic && frame->len <= size - off - sizeof(*frame);
+}
+
+static bool check_frame(int fd, u64 off, const storage_frame_t *frame) {
+    bool valid = false;
+    u8 *payload = NULL;
+
+    payload = (u8 *)malloc(max(frame->len, 1U));
+    if (NULL == payload)
+        return false;
+
+    if (frame->len == (u32)pread(fd, payload, frame->len, (off_t)(off + sizeof(*frame))))
+        valid = (frame->crc == storage_frameCrc(frame, payload));
+
+    free(payload);
+
+    return valid;
+}
+
+static u64 scan_tail(int fd, u32 *next_seq) {
+    struct stat st = {0};
+    storage_frame_t frame = {0};
+    u64 chain[STORAGE_SCAN_DEPTH] = {0};
+    u64 size = 0, off = 0, end = 0;
+    usize chain_len = 0;
+
+    *next_seq = 0;
+    if (fstat(fd, &st) < 0)
+        return 0;
+    size = (u64)st.st_size;
+
+    /* 1. Header chain - stops at padding, a torn header or a sequence gap */
+    while (read_frame(fd, off, size, &frame) && (0 == chain_len || frame.seq == *next_seq)) {
+        chain[chain_len++ % STORAGE_SCAN_DEPTH] = off;
+        *next_seq = frame.seq + 1;
+        off += sizeof(frame) + frame.len;
+    }
+
+    /* 2. The last frame with a valid CRC ends the valid data */
+    for (usize i = 0; i < min(chain_len, (usize)STORAGE_SCAN_DEPTH); i++) {
+        off = chain[(chain_len - 1 - i) % STORAGE_SCAN_DEPTH];
+        if (read_frame(fd, off, size, &frame) && check_frame(fd, off, &frame)) {
+            *next_seq = frame.seq + 1;
+            return off + sizeof(frame) + frame.len;
+        }
+    }
+
+    /* 3. Damage reaching deeper than the scan depth, verify every frame from the start */
+    off = 0;
+    *next_seq = 0;
+    while (chain_len > STORAGE_SCAN_DEPTH && read_frame(fd, off, size, &frame) && check_frame(fd, off, &frame)) {
+        *next_seq = frame.seq + 1;
+        off += sizeof(frame) + frame.len;
+        end = off;
+    }
+
+    return end;
+}
+
+static stdret_t open_segment(storage_t *store, const bool resume) {
+    int ret = 0;
+    u64 used = 0;
+    char seg_path[80] = {0};
+
+    snprintf(seg_path, sizeof(seg_path), STORAGE_SEG_FMT, store->path, store->seg_seq);
+
+    store->fd = open(seg_path, O_RDWR | O_CREAT | O_CLOEXEC | (resume ? 0 : O_TRUNC), STORAGE_FILE_MODE);
+    if (store->fd < 0) {
+        fprintf(stderr, "ERROR: Could not create segment %s\n", seg_path);
+        return STD_NOT_OK;
+    }
+
+    /* Whatever follows the last valid frame is cut before the segment is extended again */
+    if (resume) {
+        used = scan_tail(store->fd, &store->frame_seq);
+        if (ftruncate(store->fd, (off_t)used) < 0)
+            fprintf(stderr, "ERROR: Could not cut the tail of %s\n", seg_path);
+    }
+
+    /* Extents are reserved once, writes into the mapping never allocate */
+    ret = posix_fallocate(store->fd, 0, STORAGE_SEG_SIZE);
+    if (0 != ret) {
+        fprintf(stderr, "ERROR: Could not preallocate segment %s: %s\n", seg_path, strerror(ret));
+        close(store->fd);
+        store->fd = -1;
+        return STD_NOT_OK;
+    }
+
+    store->seg_map = (u8 *)mmap(NULL, STORAGE_SEG_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, store->fd, 0);
+    if (MAP_FAILED == store->seg_map) {
+        fprintf(stderr, "ERROR: Could not map segment %s\n", seg_path);
+        store->seg_map = NULL;
+        close(store->fd);
+        store->fd = -1;
+        return STD_NOT_OK;
+    }
+
+    store->seg_used = used;
+    store->seg_synced = used;
+    store->flush_ms = habtime_nowNs() / MICRO;
+
+    return STD_OK;
+}
+
+static void close_segment(storage_t *store) {
+    if (NULL != store->seg_map) {
+        (void)msync(store->seg_map, STORAGE_SEG_SIZE, MS_SYNC);
+        (void)munmap(store->seg_map, STORAGE_SEG_SIZE);
+        store->seg_map = NULL;
+    }
+
+    if (store->fd >= 0) {
+        /* Readers see only the written part of the segment */
+        if (ftruncate(store->fd, store->seg_used) < 0)
+            fprintf(stderr, "ERROR: Could not trim segment %u of %s\n", store->seg_seq, store->path);
+        close(store->fd);
+        store->fd = -1;
+    }
+}
+
+static stdret_t open_direct(storage_t *store, const bool resume) {
+    int fd = -1;
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (resume ? 0 : O_TRUNC);
+    u64 end = 0;
+    char seg_path[80] = {0};
+
+    snprintf(seg_path, sizeof(seg_path), STORAGE_SEG_FMT, store->path, store->seg_seq);
+
+    if (0 != posix_memalign((void **)&store->blk, STORAGE_DIRECT_ALIGN, STORAGE_BLOCK_SIZE)) {
+        fprintf(stderr, "ERROR: Could not allocate a write block for %s\n", seg_path);
+        return STD_NOT_OK;
+    }
+    memset(store->blk, 0, STORAGE_BLOCK_SIZE);
+
+    /* The valid part of the last block is loaded back, so the block is completed in place */
+    if (resume) {
+        fd = open(seg_path, O_RDWR | O_CLOEXEC);
+        if (fd >= 0) {
+            end = scan_tail(fd, &store->frame_seq);
+            store->blk_off = end - end % STORAGE_BLOCK_SIZE;
+            store->blk_used = end - store->blk_off;
+            store->blk_synced = store->blk_used;
+            if ((ssize_t)store->blk_used != pread(fd, store->blk, store->blk_used, (off_t)store->blk_off) ||
+                ftruncate(fd, (off_t)end) < 0)
+                fprintf(stderr, "ERROR: Could not resume %s\n", seg_path);
+            close(fd);
+        }
+    }
+
+    store->fd = open(seg_path, flags | O_DIRECT, STORAGE_FILE_MODE);
+    if (store->fd < 0 && EINVAL == errno) {
+        /* Filesystems such as tmpfs refuse O_DIRECT, aligned block writes are still used */
+        printf("INFO: O_DIRECT is not supported for %s\n", seg_path);
+        store->fd = open(seg_path, flags, STORAGE_FILE_MODE);
+    }
+
+    if (store->fd < 0) {
+        fprintf(stderr, "ERROR: Could not create %s\n", seg_path);
+        free(store->blk);
+        store->blk = NULL;
+        return STD_NOT_OK;
+    }
+
+    store->flush_ms = habtime_nowNs() / MICRO;
+
+    return STD_OK;
+}
+
+static stdret_t sync_block(storage_t *store) {
+    usize start = store->blk_synced & ~(usize)(STORAGE_DIRECT_ALIGN - 1);
+    usize end = (store->blk_used + STORAGE_DIRECT_ALIGN - 1) & ~(usize)(STORAGE_DIRECT_ALIGN - 1);
+    ssize_t len = 0;
+
+    /* Bytes behind blk_used are zero, the tail is padded to the alignment */
+    while (start < end) {
+        len = pwrite(store->fd, store->blk + start, end - start, (off_t)(store->blk_off + start));
+        if (len < 0 && EINTR == errno)
+            continue;
+        if (len <= 0) {
+            fprintf(stderr, "ERROR: Block write to %s failed: %s\n", store->path, strerror(errno));
+            return STD_NOT_OK;
+        }
+        start += len;
+    }
+
+    store->blk_synced = store->blk_used;
+    store->flush_ms = habtime_nowNs() / MICRO;
+
+    return STD_OK;
+}
+
+static stdret_t write_direct(storage_t *store, const u8 *buff, usize size) {
+    stdret_t ret = STD_OK;
+    usize chunk = 0;
+
+    while (size > 0) {
+        chunk = min(size, STORAGE_BLOCK_SIZE - store->blk_used);
+        memcpy(store->blk + store->blk_used, buff, chunk);
+        store->blk_used += chunk;
+        buff += chunk;
+        size -= chunk;
+
+        if (STORAGE_BLOCK_SIZE == store->blk_used) {
+            ret = sync_block(store);
+            store->blk_off += STORAGE_BLOCK_SIZE;
+            store->blk_used = 0;
+            store->blk_synced = 0;
+            memset(store->blk, 0, STORAGE_BLOCK_SIZE);
+        }
+    }
+
+    return ret;
+}
+
+static void close_direct(storage_t *store) {
+    if (store->fd >= 0) {
+        (void)sync_block(store);
+        /* Drop the padding of the last block */
+        if (ftruncate(store->fd, (off_t)(store->blk_off + store->blk_used)) < 0)
+            fprintf(stderr, "ERROR: Could not trim %s\n", store->path);
+        close(store->fd);
+        store->fd = -1;
+    }
+
+    free(store->blk);
+    store->blk = NULL;
+}
+
+storage_t *storage_open(const char *path, const bool framed) {
+    storage_t *store = NULL;
+    stdret_t ret = STD_NOT_OK;
+    s32 last_seq = -1;
+
+    store = (storage_t *)calloc(1, sizeof(storage_t));
+    if (NULL == store) {
+        fprintf(stderr, "ERROR: Error allocating storage for %s\n", path);
+        return NULL;
+    }
+
+    store->mode = HAB_STORAGE_MODE;
+    store->framed = framed;
+    snprintf(store->path, sizeof(store->path), "%s", path);
+
+    /* Only a framed log can tell where its valid data ends, others continue with a new file */
+    if (STORAGE_STREAM != store->mode) {
+        last_seq = find_last_seq(path);
+        store->seg_seq = (framed && last_seq >= 0) ? (u32)last_seq : (u32)(last_seq + 1);
+    }
+
+    switch (store->mode) {
+    case STORAGE_MMAP:
+        ret = open_segment(store, framed && last_seq >= 0);
+        break;
+    case STORAGE_DIRECT:
+        ret = open_direct(store, framed && last_seq >= 0);
+        break;
+    case STORAGE_STREAM:
+    default:
+        store->fd = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, STORAGE_FILE_MODE);
+        ret = (store->fd >= 0) ? STD_OK : STD_NOT_OK;
+        if (STD_OK == ret && framed && ftruncate(store->fd, (off_t)scan_tail(store->fd, &store->frame_seq)) < 0)
+            fprintf(stderr, "ERROR: Could not cut the tail of %s\n", path);
+        if (STD_OK == ret)
+            store->stream_off = (u64)lseek(store->fd, 0, SEEK_END);
+        break;
+    }
+
+    if (STD_NOT_OK == ret) {
+        fprintf(stderr, "ERROR: Could not open storage %s\n", path);
+        free(store);
+        return NULL;
+    }
+
+    open_index(store);
+
+    return store;
+}
+
+static void open_index(storage_t *store) {
+    storage_idx_t last = {0};
+    struct stat st = {0};
+    char idx_path[80] = {0};
+
+    snprintf(idx_path, sizeof(idx_path), "%s%s", store->path, STORAGE_IDX_EXT);
+
+    store->idx_fd = open(idx_path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, STORAGE_FILE_MODE);
+    if (store->idx_fd < 0) {
+        fprintf(stderr, "ERROR: Could not open index %s\n", idx_path);
+        return;
+    }
+
+    /* A torn entry is dropped. The stamps stay on the clock of the records, a resumed log counts as a new run
+     * since the monotonic clock restarts with a reboot. */
+    if (0 == fstat(store->idx_fd, &st) && st.st_size >= (off_t)sizeof(last)) {
+        st.st_size -= st.st_size % sizeof(last);
+        if (ftruncate(store->idx_fd, st.st_size) < 0 ||
+            sizeof(last) != pread(store->idx_fd, &last, sizeof(last), st.st_size - sizeof(last)))
+            fprintf(stderr, "ERROR: Could not read index %s\n", idx_path);
+        else
+            store->idx_run = last.run + 1;
+    }
+}
+
+static bool not_newer(const storage_idx_t *entry, const u32 run, const u64 ts_ms) {
+    return entry->run < run || (entry->run == run && entry->ts_ms <= ts_ms);
+}
+
+static u64 cur_offset(const storage_t *store) {
+    switch (store->mode) {
+    case STORAGE_MMAP:
+        return store->seg_used;
+    case STORAGE_DIRECT:
+        return store->blk_off + store->blk_used;
+    case STORAGE_STREAM:
+    default:
+        return store->stream_off;
+    }
+}
+
+static void write_index(storage_t *store) {
+    storage_idx_t entry = {0};
+
+    if (store->idx_fd < 0 || 0 != store->idx_cnt++ % STORAGE_IDX_EVERY)
+        return;
+
+    entry.ts_ms = habtime_nowNs() / MICRO;
+    entry.seg_seq = store->seg_seq;
+    entry.run = store->idx_run;
+    entry.offset = cur_offset(store);
+
+    if (sizeof(entry) != write(store->idx_fd, &entry, sizeof(entry)))
+        fprintf(stderr, "ERROR: Could not update index of %s\n", store->path);
+}
+
+static stdret_t rotate_segment(storage_t *store) {
+    close_segment(store);
+    store->seg_seq++;
+
+    return open_segment(store, false);
+}
+
+static stdret_t write_raw(storage_t *store, const void *buff, usize size) {
+    ssize_t len = 0;
+    usize written = 0;
+
+    if (STORAGE_DIRECT == store->mode)
+        return write_direct(store, (const u8 *)buff, size);
+
+    if (STORAGE_MMAP != store->mode) {
+        while (written < size) {
+            len = write(store->fd, (const u8 *)buff + written, size - written);
+            if (len < 0 && EINTR == errno)
+                continue;
+            if (len <= 0)
+                return STD_NOT_OK;
+            written += len;
+            store->stream_off += len;
+        }
+        return STD_OK;
+    }
+
+    if (NULL == store->seg_map || store->seg_used + size > STORAGE_SEG_SIZE)
+        return STD_NOT_OK;
+
+    memcpy(store->seg_map + store->seg_used, buff, size);
+    store->seg_used += size;
+
+    return STD_OK;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+
+stdret_t storage_write(storage_t *store, const void *buff, usize size) {
+    storage_frame_t frame = {0};
+    usize total = store->framed ? sizeof(frame) + size : size;
+
+    if (total > STORAGE_SEG_SIZE)
+        return STD_NOT_OK;
+
+    /* A record is never split between segments */
+    if (STORAGE_MMAP == store->mode && store->seg_used + total > STORAGE_SEG_SIZE &&
+        STD_NOT_OK == rotate_segment(store))
+        return STD_NOT_OK;
+
+    write_index(store);
+
+    if (!store->framed)
+        return write_raw(store, buff, size);
+
+    frame.magic = STORAGE_FRAME_MAGIC;
+    frame.seq = store->frame_seq;
+    frame.len = (u32)size;
+    frame.crc = storage_frameCrc(&frame, buff);
+
+    if (STD_NOT_OK == write_raw(store, &frame, sizeof(frame)) || STD_NOT_OK == write_raw(store, buff, size))
+        return STD_NOT_OK;
+
+    store->frame_seq++;
+
+    return STD_OK;
+}
+
+stdret_t storage_flush(storage_t *store) {
+    usize page_size = (usize)sysconf(_SC_PAGESIZE);
+    usize start = 0;
+
+    if (STORAGE_DIRECT == store->mode) {
+        /* The partial block is rewritten on every flush, the period bounds the write amplification */
+        if (store->blk_synced == store->blk_used ||
+            habtime_nowNs() / MICRO - store->flush_ms < STORAGE_DIRECT_FLUSH_MS)
+            return STD_OK;
+        return sync_block(store);
+    }
+
+    if (STORAGE_MMAP != store->mode || NULL == store->seg_map || store->seg_synced == store->seg_used ||
+        habtime_nowNs() / MICRO - store->flush_ms < STORAGE_MMAP_FLUSH_MS)
+        return STD_OK;
+
+    /* Only the pages touched since the last flush are written back, the call blocks until they are on disk */
+    start = store->seg_synced & ~(page_size - 1);
+    if (msync(store->seg_map + start, store->seg_used - start, MS_SYNC) < 0) {
+        fprintf(stderr, "ERROR: Could not sync segment %u of %s: %s\n", store->seg_seq, store->path, strerror(errno));
+        return STD_NOT_OK;
+    }
+
+    store->seg_synced = store->seg_used;
+    store->flush_ms = habtime_nowNs() / MICRO;
+
+    return STD_OK;
+}
+
+void storage_close(storage_t *store) {
+    if (NULL == store)
+        return;
+
+    if (store->idx_fd >= 0)
+        close(store->idx_fd);
+
+    if (STORAGE_MMAP == store->mode)
+        close_segment(store);
+    else if (STORAGE_DIRECT == store->mode)
+        close_direct(store);
+    else if (store->fd >= 0)
+        close(store->fd);
+
+    free(store);
+}
+
+u32 storage_frameCrc(const storage_frame_t *frame, const void *payload) {
+    u32 crc = crc32c(0, &frame->seq, sizeof(frame->seq));
+
+    crc = crc32c(crc, &frame->len, sizeof(frame->len));
+
+    return crc32c(crc, payload, frame->len);
+}
+
+stdret_t storage_seek(const char *path, const u32 run, const u64 ts_ms, const bool upper, storage_idx_t *pos) {
+    struct stat st = {0};
+    storage_idx_t entry = {0};
+    char idx_path[80] = {0};
+    usize low = 0, high = 0, mid = 0;
+    int fd = -1;
+
+    snprintf(idx_path, sizeof(idx_path), "%s%s", path, STORAGE_IDX_EXT);
+
+    fd = open(idx_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0 || fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(entry)) {
+        if (fd >= 0)
+            close(fd);
+        return STD_NOT_OK;
+    }
+
+    /* Entries are ordered by run, then by time.
+     * Lower bound - last entry not newer than ts_ms, the first one if the log starts later.
+     * Upper bound - first entry newer than ts_ms, none if the log ends earlier. */
+    high = st.st_size / sizeof(entry);
+    while (high - low > 1) {
+        mid = low + (high - low) / 2;
+        if (sizeof(entry) != pread(fd, &entry, sizeof(entry), (off_t)(mid * sizeof(entry))))
+            break;
+        if (not_newer(&entry, run, ts_ms))
+            low = mid;
+        else
+            high = mid;
+    }
+
+    if (upper && sizeof(entry) == pread(fd, &entry, sizeof(entry), (off_t)(low * sizeof(entry))) &&
+        not_newer(&entry, run, ts_ms))
+        low++;
+
+    if (sizeof(*pos) != pread(fd, pos, sizeof(*pos), (off_t)(low * sizeof(*pos)))) {
+        close(fd);
+        return STD_NOT_OK;
+    }
+
+    close(fd);
+
+    return STD_OK;
+}
+
+void storage_getFilePath(const char *path, const u32 seg_seq, char *buff, usize size) {
+    /* Stream logs have no segment suffix */
+    snprintf(buff, size, STORAGE_SEG_FMT, path, seg_seq);
+    if (0 != access(buff, F_OK))
+        snprintf(buff, size, "%s", path);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,189 @@
+/**********************************************************************************************************************
+* storage_budget.cpp                                                                                                  *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Storage budget. Writers account their bytes with budget_account(), possibly from the uv worker threads.       *
+*       A loop timer polls the free space every BUDGET_PERIOD_MS, smooths the write rate of every class and           *
+*       picks the degradation level from the projected time to full:                                                  *
+*           time to full < remaining horizon        - BUDGET_FEWER_VIDEOS                                             *
+*           time to full < remaining horizon / 2    - BUDGET_LOW_STILLS                                               *
+*           time to full < remaining horizon / 4    - BUDGET_DECIMATE                                                 *
+*           free space   < HAB_BUDGET_RESERVE_MB    - BUDGET_SENSOR_ONLY                                              *
+*       A level is only relaxed once the projection clears its threshold by a quarter, so the policy does not         *
+*       flap on a noisy rate.                                                                                         *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            budget_start(uv_loop_t *loop);                                                            *
+*       void                budget_account(const budget_class_t cls, const usize bytes);                              *
+*       budget_level_t      budget_getLevel(void);                                                                    *
+*       bool                budget_allowMedia(const budget_class_t cls);                                              *
+*       u8                  budget_getStillQuality(void);                                                             *
+*       bool                budget_keepSensor(const u32 dev_idx);                                                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/statvfs.h>
+
+#include "utils.h"
+#include "storage_budget.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define BUDGET_MIB              (1024ULL * 1024ULL)
+#define BUDGET_RESERVE          ((u64)HAB_BUDGET_RESERVE_MB * BUDGET_MIB)
+/* Weight of the newest period in the smoothed rate, in 1/8 */
+#define BUDGET_RATE_WEIGHT      2U
+#define BUDGET_TTF_INFINITE     (~0ULL)
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const u8 dev_log_prio[] = HAB_DEV_LOG_PRIO;
+static const char *level_names[] = {"NORMAL", "FEWER_VIDEOS", "LOW_STILLS", "DECIMATE", "SENSOR_ONLY"};
+
+static u64 class_bytes[BUDGET_CLASS_NUM];
+static u64 class_seen[BUDGET_CLASS_NUM];
+static u64 class_rate[BUDGET_CLASS_NUM];    /* Bytes per second */
+
+static budget_level_t level;
+static u32 video_cnt;
+static u32 sensor_cnt[ARRAY_SIZE(dev_log_prio)];
+
+static uv_timer_t *budget_tim;
+static u64 start_ms;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static budget_level_t level_for(const u64 free_bytes, const u64 ttf_s, const u64 horizon_s) {
+    if (free_bytes < BUDGET_RESERVE)
+        return BUDGET_SENSOR_ONLY;
+    if (ttf_s < horizon_s / 4)
+        return BUDGET_DECIMATE;
+    if (ttf_s < horizon_s / 2)
+        return BUDGET_LOW_STILLS;
+    if (ttf_s < horizon_s)
+        return BUDGET_FEWER_VIDEOS;
+    return BUDGET_NORMAL;
+}
+
+static void update_rates(u64 *total_rate) {
+    u64 bytes = 0, period_rate = 0;
+
+    *total_rate = 0;
+    for (int i = 0; i < BUDGET_CLASS_NUM; i++) {
+        bytes = __atomic_load_n(&class_bytes[i], __ATOMIC_RELAXED);
+        period_rate = (bytes - class_seen[i]) * 1000U / BUDGET_PERIOD_MS;
+        class_seen[i] = bytes;
+
+        class_rate[i] = (class_rate[i] * (8U - BUDGET_RATE_WEIGHT) + period_rate * BUDGET_RATE_WEIGHT) / 8U;
+        *total_rate += class_rate[i];
+    }
+}
+
+static void on_budget_tim(uv_timer_t *handle) {
+    struct statvfs st = {0};
+    budget_level_t next = BUDGET_NORMAL;
+    u64 free_bytes = 0, total_rate = 0, ttf_s = BUDGET_TTF_INFINITE;
+    u64 elapsed_s = 0, horizon_s = 0;
+
+    if (0 != statvfs(HAB_DATASTORAGE_PATH, &st)) {
+        fprintf(stderr, "ERROR: Could not get the free space of %s\n", HAB_DATASTORAGE_PATH);
+        return;
+    }
+
+    free_bytes = (u64)st.f_bavail * st.f_frsize;
+    update_rates(&total_rate);
+
+    if (0 != total_rate)
+        ttf_s = (free_bytes > BUDGET_RESERVE) ? (free_bytes - BUDGET_RESERVE) / total_rate : 0;
+
+    /* Remaining part of the mission, never shorter than a poll period */
+    elapsed_s = (uv_now(handle->loop) - start_ms) / 1000U;
+    horizon_s = (elapsed_s + BUDGET_PERIOD_MS / 1000U < HAB_BUDGET_HORIZON_S) ?
+                    HAB_BUDGET_HORIZON_S - elapsed_s : BUDGET_PERIOD_MS / 1000U;
+
+    next = level_for(free_bytes, ttf_s, horizon_s);
+    if (next < level)
+        next = max(next, level_for(free_bytes - free_bytes / 5, ttf_s - ttf_s / 5, horizon_s));
+
+    if (next != level) {
+        printf("INFO: Storage budget %s -> %s, %llu MiB free, %llu s to full.\n", level_names[level],
+                level_names[next], (unsigned long long)(free_bytes / BUDGET_MIB), (unsigned long long)ttf_s);
+        __atomic_store_n(&level, next, __ATOMIC_RELAXED);
+    }
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t budget_start(uv_loop_t *loop) {
+    if (NULL != budget_tim)
+        return STD_OK;
+
+    budget_tim = (uv_timer_t *)malloc(sizeof(uv_timer_t));
+    if (NULL == budget_tim)
+        return STD_NOT_OK;
+
+    start_ms = uv_now(loop);
+    uv_timer_init(loop, budget_tim);
+    uv_timer_start(budget_tim, on_budget_tim, 0, BUDGET_PERIOD_MS);
+
+    return STD_OK;
+}
+
+void budget_account(const budget_class_t cls, const usize bytes) {
+    __atomic_fetch_add(&class_bytes[cls], (u64)bytes, __ATOMIC_RELAXED);
+}
+
+budget_level_t budget_getLevel(void) {
+    return __atomic_load_n(&level, __ATOMIC_RELAXED);
+}
+
+bool budget_allowMedia(const budget_class_t cls) {
+    budget_level_t curr = budget_getLevel();
+
+    if (BUDGET_SENSOR_ONLY == curr)
+        return false;
+
+    if (BUDGET_VIDEO != cls || BUDGET_NORMAL == curr)
+        return true;
+
+    if (BUDGET_FEWER_VIDEOS == curr)
+        return 0 == __atomic_fetch_add(&video_cnt, 1U, __ATOMIC_RELAXED) % BUDGET_VIDEO_DIV;
+
+    return false;
+}
+
+u8 budget_getStillQuality(void) {
+    return (budget_getLevel() >= BUDGET_LOW_STILLS) ? BUDGET_STILL_QUALITY : 0;
+}
+
+bool budget_keepSensor(const u32 dev_idx) {
+    if (dev_idx >= ARRAY_SIZE(dev_log_prio) || BUDGET_PRIO_HIGH == dev_log_prio[dev_idx])
+        return true;
+
+    if (budget_getLevel() < BUDGET_DECIMATE)
+        return true;
+
+    return 0 == sensor_cnt[dev_idx]++ % BUDGET_DECIMATION;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
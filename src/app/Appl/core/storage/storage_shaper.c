@@ -0,0 +1,143 @@
+/**********************************************************************************************************************
+* storage_shaper.cpp                                                                                                  *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       I/O shaper. I/O priorities are per thread, a class is set on the thread that writes or forks the writer:      *
+*           BUDGET_SENSOR   - best effort, level 0                                                                    *
+*           BUDGET_STILL    - best effort, level 7                                                                    *
+*           BUDGET_VIDEO    - idle, served only when the card has nothing else to do                                  *
+*       Media token buckets are refilled with HAB_IO_MEDIA_KBPS. A capture is admitted while its bucket is not in     *
+*       debt and pays its real size once it is written, so a single video may overdraw the bucket and delays the      *
+*       following captures instead.                                                                                   *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       int                 shaper_setThreadClass(const budget_class_t cls);                                          *
+*       void                shaper_restoreThread(const int ioprio);                                                   *
+*       bool                shaper_acquire(const budget_class_t cls);                                                 *
+*       void                shaper_consume(const budget_class_t cls, const usize bytes);                              *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#include "utils.h"
+#include "storage_shaper.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+/* linux/ioprio.h is not shipped by every toolchain */
+#define IOPRIO_CLASS_SHIFT      13
+#define IOPRIO_CLASS_BE         2
+#define IOPRIO_CLASS_IDLE       3
+#define IOPRIO_WHO_PROCESS      1
+#define IOPRIO_VALUE(cls, lvl)  (((cls) << IOPRIO_CLASS_SHIFT) | (lvl))
+
+#define SHAPER_RATE             ((s64)HAB_IO_MEDIA_KBPS * 1024)
+#define SHAPER_BURST            ((s64)HAB_IO_MEDIA_BURST_MB * 1024 * 1024)
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    s64 tokens;
+    u64 refill_ms;
+} bucket_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const int class_ioprio[BUDGET_CLASS_NUM] = {
+    [BUDGET_SENSOR] = IOPRIO_VALUE(IOPRIO_CLASS_BE, 0),
+    [BUDGET_STILL]  = IOPRIO_VALUE(IOPRIO_CLASS_BE, 7),
+    [BUDGET_VIDEO]  = IOPRIO_VALUE(IOPRIO_CLASS_IDLE, 0),
+};
+
+static bucket_t bucket_list[BUDGET_CLASS_NUM];
+static pthread_mutex_t bucket_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 now_ms(void) {
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec * 1000U + (u64)ts.tv_nsec / MICRO;
+}
+
+/* Lock shall be held */
+static void refill(bucket_t *bucket) {
+    u64 now = now_ms();
+
+    /* Buckets start full */
+    if (0 == bucket->refill_ms)
+        bucket->tokens = SHAPER_BURST;
+    else
+        bucket->tokens = min(bucket->tokens + (s64)((now - bucket->refill_ms) * SHAPER_RATE / 1000), SHAPER_BURST);
+
+    bucket->refill_ms = now;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int shaper_setThreadClass(const budget_class_t cls) {
+    int prev = (int)syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, 0);
+
+    if (0 != syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, class_ioprio[cls]))
+        fprintf(stderr, "ERROR: Could not set the I/O priority of class %d. errno: %d\n", cls, errno);
+
+    return prev;
+}
+
+void shaper_restoreThread(const int ioprio) {
+    if (ioprio >= 0)
+        (void)syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, ioprio);
+}
+
+bool shaper_acquire(const budget_class_t cls) {
+    bool ret = true;
+
+    if (BUDGET_SENSOR == cls)
+        return true;
+
+    pthread_mutex_lock(&bucket_lock);
+    refill(&bucket_list[cls]);
+    ret = bucket_list[cls].tokens > 0;
+    pthread_mutex_unlock(&bucket_lock);
+
+    return ret;
+}
+
+void shaper_consume(const budget_class_t cls, const usize bytes) {
+    if (BUDGET_SENSOR == cls)
+        return;
+
+    pthread_mutex_lock(&bucket_lock);
+    refill(&bucket_list[cls]);
+    bucket_list[cls].tokens -= (s64)bytes;
+    pthread_mutex_unlock(&bucket_lock);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,164 @@
+/**********************************************************************************************************************
+* telemetry.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Writer side of the live telemetry segment. Slots are written by the uv loop thread only, so the sequence      *
+*       counter needs no read-modify-write, just the ordering of the counter stores around the slot update.           *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            telem_open(void);                                                                         *
+*       void                telem_publish(u8 dev_idx, const s64 *vals, const double *si, u8 chan_num, u64 ts_ns,      *
+*                                         u32 err_mask);                                                              *
+*       void                telem_setStatus(u8 dev_idx, telem_status_t status);                                       *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "utils.h"
+#include "telemetry.h"
+#include "hab_time.h"
+
+/**********************************************************************************************************************
+ *  MACRO
+ *********************************************************************************************************************/
+#ifndef HAB_DEV_NAME
+# error "ERROR: Device list is not specified."
+#endif
+
+_Static_assert(0 == sizeof(telem_dev_t) % 64U, "Telemetry slots have to fill whole cache lines");
+_Static_assert(64U == sizeof(telem_hdr_t), "Telemetry header has to fill one cache line");
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const char *dev_names[] = HAB_DEV_NAME;
+
+static telem_hdr_t *telem_hdr;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static telem_dev_t *get_slot(const u8 dev_idx) {
+    if (NULL == telem_hdr || dev_idx >= telem_hdr->dev_num)
+        return NULL;
+
+    return (telem_dev_t *)TELEM_DEV(telem_hdr, dev_idx);
+}
+
+/* The odd counter has to be visible before any store to the slot */
+static void write_begin(telem_dev_t *dev) {
+    __atomic_store_n(&dev->seq, dev->seq + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void write_end(telem_dev_t *dev) {
+    dev->update_cnt++;
+    dev->update_ns = habtime_nowNs();
+    __atomic_store_n(&dev->seq, dev->seq + 1U, __ATOMIC_RELEASE);
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t telem_open(void) {
+    usize size = sizeof(telem_hdr_t) + ARRAY_SIZE(dev_names) * sizeof(telem_dev_t);
+    telem_dev_t *dev = NULL;
+    void *seg = NULL;
+    int fd = -1;
+
+    if (NULL != telem_hdr)
+        return STD_OK;
+
+    /* A segment left by a previous run is reused, its content is reset below */
+    fd = shm_open(TELEM_SHM_NAME, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0)
+        return STD_NOT_OK;
+
+    if (0 == ftruncate(fd, (off_t)size))
+        seg = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (NULL == seg || MAP_FAILED == seg)
+        return STD_NOT_OK;
+
+    memset(seg, 0, size);
+    telem_hdr = (telem_hdr_t *)seg;
+
+    telem_hdr->version  = TELEM_VERSION;
+    telem_hdr->dev_num  = (u16)ARRAY_SIZE(dev_names);
+    telem_hdr->dev_size = (u16)sizeof(telem_dev_t);
+    telem_hdr->chan_max = (u16)TELEM_CHAN_MAX;
+    telem_hdr->pid      = (u32)getpid();
+    telem_hdr->start_ns = habtime_nowNs();
+
+    for (usize i = 0; i < ARRAY_SIZE(dev_names); i++) {
+        dev = get_slot((u8)i);
+        strncpy(dev->name, dev_names[i], sizeof(dev->name) - 1);
+    }
+
+    /* Readers check the magic first, it is stored once the layout is complete */
+    __atomic_store_n(&telem_hdr->magic, TELEM_MAGIC, __ATOMIC_RELEASE);
+
+    return STD_OK;
+}
+
+void telem_publish(u8 dev_idx, const s64 *vals, const double *si, u8 chan_num, u64 ts_ns, u32 err_mask) {
+    telem_dev_t *dev = get_slot(dev_idx);
+
+    if (NULL == dev)
+        return;
+
+    chan_num = min(chan_num, (u8)TELEM_CHAN_MAX);
+
+    write_begin(dev);
+
+    dev->chan_num = chan_num;
+    for (u8 i = 0; i < chan_num; i++) {
+        if (err_mask & (1U << i)) {
+            dev->chan[i].status = TELEM_ERROR;
+            continue;
+        }
+        dev->chan[i].value  = vals[i];
+        dev->chan[i].si     = si[i];
+        dev->chan[i].ts_ns  = ts_ns;
+        dev->chan[i].status = TELEM_OK;
+    }
+
+    write_end(dev);
+}
+
+void telem_setStatus(u8 dev_idx, telem_status_t status) {
+    telem_dev_t *dev = get_slot(dev_idx);
+
+    if (NULL == dev)
+        return;
+
+    write_begin(dev);
+
+    for (u8 i = 0; i < dev->chan_num; i++)
+        dev->chan[i].status = status;
+
+    write_end(dev);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+* telemetry_reader.cpp                                                                                                *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Reader side of the live telemetry segment, linked into any process that wants the live values.                *
+*       Once the segment is attached, a snapshot is a plain copy of the slot between two counter loads.               *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       const telem_hdr_t * telem_attach(void);                                                                       *
+*       stdret_t            telem_snapshot(const telem_hdr_t *hdr, u8 dev_idx, telem_dev_t *dev);                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "telemetry.h"
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+const telem_hdr_t *telem_attach(void) {
+    const telem_hdr_t *hdr = NULL;
+    struct stat st = {0};
+    void *seg = NULL;
+    int fd = -1;
+
+    fd = shm_open(TELEM_SHM_NAME, O_RDONLY, 0);
+    if (fd < 0)
+        return NULL;
+
+    if (0 == fstat(fd, &st) && (usize)st.st_size >= sizeof(telem_hdr_t))
+        seg = mmap(NULL, (usize)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (NULL == seg || MAP_FAILED == seg)
+        return NULL;
+
+    hdr = (const telem_hdr_t *)seg;
+    if (TELEM_MAGIC != __atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) || TELEM_VERSION != hdr->version ||
+        sizeof(telem_dev_t) != hdr->dev_size ||
+        (usize)st.st_size < sizeof(telem_hdr_t) + (usize)hdr->dev_num * hdr->dev_size) {
+        fprintf(stderr, "ERROR: Telemetry segment is not initialized or has an unknown layout.\n");
+        munmap(seg, (usize)st.st_size);
+        return NULL;
+    }
+
+    return hdr;
+}
+
+stdret_t telem_snapshot(const telem_hdr_t *hdr, u8 dev_idx, telem_dev_t *dev) {
+    const telem_dev_t *slot = NULL;
+    u32 seq_start = 0, seq_end = 0;
+
+    if (NULL == hdr || dev_idx >= hdr->dev_num)
+        return STD_NOT_OK;
+
+    slot = TELEM_DEV(hdr, dev_idx);
+
+    for (u32 i = 0; i < TELEM_READ_TRIES; i++) {
+        seq_start = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq_start & 1U)
+            continue;
+
+        memcpy(dev, slot, sizeof(*dev));
+
+        /* The copy has to complete before the counter is loaded again */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        seq_end = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+        if (seq_start == seq_end)
+            return STD_OK;
+    }
+
+    return STD_NOT_OK;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
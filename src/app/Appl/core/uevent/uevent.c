@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+* uevent.cpp                                                                                                          *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Kernel uevent monitor. A single NETLINK_KOBJECT_UEVENT socket is polled by the uv loop and every              *
+*       received message is dispatched to the registered listeners. The socket is opened with the first               *
+*       listener and kept open for the whole run, so a listener that replaces another one also receives the           *
+*       uevents queued in between.                                                                                    *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            uevent_addListener(uv_loop_t *loop, uevent_cb_t cb)                                       *
+*       void                uevent_removeListener(uevent_cb_t cb)                                                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+#include "utils.h"
+#include "uevent.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define UEVENT_MSG_SIZE      4096
+#define UEVENT_LISTENER_MAX  8
+#define UEVENT_KERNEL_GROUP  1
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static uevent_cb_t listener_list[UEVENT_LISTENER_MAX];
+static usize listener_cnt;
+
+static int nl_fd = -1;
+static uv_poll_t *nl_poll;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+static stdret_t nl_open(uv_loop_t *loop);
+static void nl_read(uv_poll_t *handle, int status, int events);
+static void dispatch(char *msg, usize size);
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static stdret_t nl_open(uv_loop_t *loop) {
+    struct sockaddr_nl addr = {0};
+
+    nl_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (nl_fd < 0) {
+        fprintf(stderr, "ERROR: Could not open uevent socket. errno: %d\n", errno);
+        return STD_NOT_OK;
+    }
+
+    addr.nl_family = AF_NETLINK;
+    addr.nl_pid    = 0;
+    addr.nl_groups = UEVENT_KERNEL_GROUP;
+    if (bind(nl_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr, "ERROR: Could not bind uevent socket. errno: %d\n", errno);
+        close(nl_fd);
+        nl_fd = -1;
+        return STD_NOT_OK;
+    }
+
+    nl_poll = (uv_poll_t *)malloc(sizeof(uv_poll_t));
+    if (NULL == nl_poll) {
+        fprintf(stderr, "ERROR: Error allocating uevent poll handle.\n");
+        close(nl_fd);
+        nl_fd = -1;
+        return STD_NOT_OK;
+    }
+
+    uv_poll_init(loop, nl_poll, nl_fd);
+    uv_poll_start(nl_poll, UV_READABLE, nl_read);
+
+    return STD_OK;
+}
+
+/**
+ * Kernel messages are "ACTION@DEVPATH" followed by NUL separated KEY=VALUE pairs.
+ */
+static void dispatch(char *msg, usize size) {
+    uevent_t uev = {0};
+    char *pos = msg;
+    char *kobj = NULL;
+    uevent_cb_t listeners[UEVENT_LISTENER_MAX];
+    usize cnt = listener_cnt;
+
+    msg[size] = '\0';
+    if (NULL == strchr(msg, '@'))
+        return;
+
+    while (pos < msg + size) {
+        if (0 == strncmp(pos, "ACTION=", 7))
+            uev.action = pos + 7;
+        else if (0 == strncmp(pos, "DEVPATH=", 8))
+            uev.devpath = pos + 8;
+        else if (0 == strncmp(pos, "SUBSYSTEM=", 10))
+            uev.subsystem = pos + 10;
+
+        pos += strlen(pos) + 1;
+    }
+
+    if (NULL == uev.action || NULL == uev.devpath)
+        return;
+
+    kobj = strrchr(uev.devpath, '/');
+    uev.kobj_name = (NULL != kobj) ? kobj + 1 : uev.devpath;
+
+    /* Listeners are allowed to unregister themselves from within the callback */
+    memcpy(listeners, listener_list, sizeof(listeners));
+    for (usize i = 0; i < cnt; i++)
+        listeners[i](&uev);
+}
+
+static void nl_read(uv_poll_t *handle, int status, int events) {
+    char msg[UEVENT_MSG_SIZE + 1];
+    ssize_t len = 0;
+
+    (void)handle;
+    (void)events;
+
+    if (status < 0)
+        return;
+
+    /* The socket is non-blocking, drain everything queued since the last wakeup */
+    while (nl_fd >= 0 && (len = recv(nl_fd, msg, UEVENT_MSG_SIZE, 0)) > 0)
+        dispatch(msg, (usize)len);
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t uevent_addListener(uv_loop_t *loop, uevent_cb_t cb) {
+    if (listener_cnt >= UEVENT_LISTENER_MAX) {
+        fprintf(stderr, "ERROR: Too many uevent listeners.\n");
+        return STD_NOT_OK;
+    }
+
+    if (nl_fd < 0 && STD_NOT_OK == nl_open(loop))
+        return STD_NOT_OK;
+
+    listener_list[listener_cnt++] = cb;
+
+    return STD_OK;
+}
+
+void uevent_removeListener(uevent_cb_t cb) {
+    for (usize i = 0; i < listener_cnt; i++) {
+        if (cb == listener_list[i]) {
+            listener_list[i] = listener_list[--listener_cnt];
+            break;
+        }
+    }
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
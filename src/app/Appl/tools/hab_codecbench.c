@@ -0,0 +1,337 @@
+/**********************************************************************************************************************
+* hab_codecbench.cpp                                                                                                  *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Compression check of the log codec on the slow sensors logged as .dz.                                         *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_codecbench [<scans>]                                                                                  *
+*                                                                                                                     *
+*       Synthesizes the scans of the MPRLS, SHT40 and MLX90614 with their buffer layout, trigger period,              *
+*       sensor noise, a drift like during the ascent and IIO timestamps with hrtimer jitter. Every block is           *
+*       decoded back and compared to the scans, an unsigned channel with its top bit set included. The size           *
+*       of the framed .dz log is compared to the hexdump of the same scans, the tool fails below                      *
+*       BENCH_MIN_RATIO. Edge cases - full range 64 bit words, constant channels and short blocks - are               *
+*       round tripped as well, so are compression stage blocks of random data, long runs and hexdump text             *
+*       up to LOGZIP_BLOCK_SIZE at the fastest and the best level.                                                    *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils.h"
+#include "storage.h"
+#include "iio_scan.h"
+#include "log_codec.h"
+#include "log_zip.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define BENCH_SCANS         4096U
+#define BENCH_MIN_RATIO     10.0
+#define BENCH_CHAN_MAX      4U
+#define BENCH_SCAN_MAX      64U
+/* Wake-up latency of the hrtimer trigger, the IIO timestamp is taken in its handler */
+#define BENCH_JITTER_NS     20000U
+#define BENCH_NS_PER_MS     1000000ULL
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    s64 base;
+    s64 slope;              /* Counts per 1024 scans */
+    u32 noise;              /* Peak counts */
+} bench_chan_t;
+
+typedef struct {
+    const char *name;
+    data_format_t df;
+    u16 sign_mask;
+    u32 period_ms;
+    bench_chan_t chan[BENCH_CHAN_MAX];
+} bench_dev_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+/* Raw counts of the drivers, the timestamp is the last channel */
+static const bench_dev_t bench_devs[] = {
+    /* 24 bit pressure output in a u32, the ascent lowers it by ~0.5 hPa per second */
+    {"mprls0025", {2, {32, 64}, true}, 0x2, 1000, {{0x00A00000, -3600 * 1024, 24}}},
+    /* Humidity ticks above 0x8000 and temperature ticks, both u16 */
+    {"sht4x", {3, {16, 16, 64}, true}, 0x4, 10000, {{0x9A00, -30 * 1024, 24}, {0x6400, -40 * 1024, 12}}},
+    /* Ambient and object temperature in 0.02 K */
+    {"mlx90614", {3, {16, 16, 64}, true}, 0x4, 10000, {{0x3A98, -25 * 1024, 4}, {0x3A20, -60 * 1024, 10}}},
+};
+
+static u64 rand_state = 0x9E3779B97F4A7C15ULL;
+static u8  block_out[LOGCODEC_BLOCK_MAX];
+static u8  zip_raw[LOGZIP_BLOCK_SIZE + 1];     /* Room for the terminator of the hexdump text */
+static u8  zip_out[LOGZIP_BLOCK_MAX];
+static u8  zip_back[LOGZIP_BLOCK_SIZE];
+static s64 block_vals[LOGCODEC_BLOCK_REC * LOGCODEC_CHAN_MAX];
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 next_rand(void) {
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+
+    return rand_state;
+}
+
+/* Triangular noise in [-peak, peak] */
+static s64 noise(u32 peak) {
+    if (0 == peak)
+        return 0;
+
+    return (s64)(next_rand() % (peak + 1U)) - (s64)(next_rand() % (peak + 1U));
+}
+
+static void write_le(u8 *dst, u64 val, u8 bits) {
+    for (u8 i = 0; i < bits / BYTE; i++)
+        dst[i] = (u8)(val >> (i * BYTE));
+}
+
+static void make_scan(const bench_dev_t *dev, u64 idx, u8 *scan, s64 *vals) {
+    usize pos = 0, bytes = 0;
+    u64 val = 0;
+    u8 bits = 0;
+
+    memset(scan, 0, BENCH_SCAN_MAX);
+
+    for (u8 i = 0; i < dev->df.chan_num; i++) {
+        bits = dev->df.storagebits[i];
+        bytes = bits / BYTE;
+        pos = (pos + bytes - 1) / bytes * bytes;
+
+        if (dev->df.ts_en && i == dev->df.chan_num - 1)
+            val = 1000000000ULL + idx * dev->period_ms * BENCH_NS_PER_MS + next_rand() % BENCH_JITTER_NS;
+        else
+            val = (u64)(dev->chan[i].base + dev->chan[i].slope * (s64)idx / 1024 + noise(dev->chan[i].noise));
+
+        /* The value the codec is expected to return, zero or sign extended from the storage word */
+        if (bits < 64)
+            val &= (1ULL << bits) - 1;
+        vals[i] = (bits < 64 && (dev->sign_mask & (1U << i)) && (val >> (bits - 1))) ? (s64)(val | (~0ULL << bits))
+                                                                                     : (s64)val;
+        write_le(scan + pos, val, bits);
+        pos += bytes;
+    }
+}
+
+static stdret_t check_block(const u8 *block, usize len, const s64 *expect, usize first, u8 chan_num) {
+    usize used = 0;
+    u8 chan = 0, rec = 0;
+
+    if (STD_NOT_OK == logcodec_decode(block, len, &used, block_vals, &chan, &rec) || used != len || chan != chan_num) {
+        fprintf(stderr, "ERROR: Block at scan %zu does not decode.\n", first);
+        return STD_NOT_OK;
+    }
+
+    if (0 != memcmp(block_vals, expect + first * chan_num, (usize)rec * chan_num * sizeof(s64))) {
+        fprintf(stderr, "ERROR: Block at scan %zu decodes to other values.\n", first);
+        return STD_NOT_OK;
+    }
+
+    return STD_OK;
+}
+
+/* Encodes the scans, checks every block and returns the size of the framed log, 0 on a failure */
+static usize encode_all(const data_format_t *df, u16 sign_mask, const u8 *scans, const s64 *vals, usize scan_num) {
+    logcodec_t *codec = logcodec_alloc(df, sign_mask);
+    usize scan_len = iioscan_scanSize(df);
+    usize total = 0, len = 0, first = 0;
+
+    if (NULL == codec)
+        return 0;
+
+    for (usize i = 0; i <= scan_num; i++) {
+        len = (i < scan_num) ? logcodec_push(codec, scans + i * scan_len, block_out, sizeof(block_out))
+                             : logcodec_flush(codec, block_out, sizeof(block_out));
+        if (0 == len)
+            continue;
+
+        if (STD_NOT_OK == check_block(block_out, len, vals, first, df->chan_num)) {
+            logcodec_free(codec);
+            return 0;
+        }
+        total += sizeof(storage_frame_t) + len;
+        first = i + 1;
+    }
+
+    logcodec_free(codec);
+
+    return total;
+}
+
+static stdret_t bench_dev(const bench_dev_t *dev, usize scan_num) {
+    usize scan_len = iioscan_scanSize(&dev->df);
+    usize enc_len = 0, hex_len = 0;
+    char *hex = NULL;
+    u8 *scans = NULL;
+    s64 *vals = NULL;
+    double ratio = 0;
+
+    scans = (u8 *)calloc(scan_num + 1, BENCH_SCAN_MAX);
+    vals = (s64 *)calloc(scan_num, dev->df.chan_num * sizeof(s64));
+    hex = (char *)malloc(4U * HEXDUMP_RECORD_LEN * (scan_num * scan_len / HEXDUMP_RECORD_LEN + 1));
+    if (NULL == scans || NULL == vals || NULL == hex) {
+        fprintf(stderr, "ERROR: Out of memory.\n");
+        free(scans);
+        free(vals);
+        free(hex);
+        return STD_NOT_OK;
+    }
+
+    for (usize i = 0; i < scan_num; i++)
+        make_scan(dev, i, scans + i * scan_len, vals + i * dev->df.chan_num);
+
+    enc_len = encode_all(&dev->df, dev->sign_mask, scans, vals, scan_num);
+    hex_len = hexdump_str(hex, 4U * HEXDUMP_RECORD_LEN * (scan_num * scan_len / HEXDUMP_RECORD_LEN + 1),
+                          (const char *)scans, scan_num * scan_len / HEXDUMP_RECORD_LEN, NULL);
+    ratio = (0 != enc_len) ? (double)hex_len / (double)enc_len : 0;
+
+    printf("%-10s %6zu scans %9zu B hex %8zu B dz %6.2f B/scan %6.2fx\n", dev->name, scan_num, hex_len, enc_len,
+           (double)enc_len / (double)scan_num, ratio);
+
+    free(scans);
+    free(vals);
+    free(hex);
+
+    if (0 == enc_len)
+        return STD_NOT_OK;
+
+    if (ratio < BENCH_MIN_RATIO) {
+        fprintf(stderr, "ERROR: %s is compressed %.2fx, below %.1fx.\n", dev->name, ratio, BENCH_MIN_RATIO);
+        return STD_NOT_OK;
+    }
+
+    return STD_OK;
+}
+
+static stdret_t bench_edges(void) {
+    /* u64, s8 and u16 channels, a whole scan is 16 bytes */
+    const data_format_t df = {3, {64, 8, 16}, false};
+    const usize scan_len = iioscan_scanSize(&df);
+    const usize lens[] = {1, 2, 3, LOGCODEC_BLOCK_REC - 1, LOGCODEC_BLOCK_REC, 3 * LOGCODEC_BLOCK_REC + 5};
+    u8 scans[(3 * LOGCODEC_BLOCK_REC + 5) * 16] = {0};
+    s64 vals[(3 * LOGCODEC_BLOCK_REC + 5) * 3] = {0};
+    u64 val = 0;
+
+    for (usize i = 0; i < ARRAY_SIZE(lens); i++) {
+        for (usize j = 0; j < lens[i]; j++) {
+            /* Random full range words, a negative s8 step and a constant u16 */
+            val = next_rand();
+            write_le(scans + j * scan_len, val, 64);
+            vals[j * 3] = (s64)val;
+            scans[j * scan_len + 8] = (u8)(0x80 + j % 3);
+            vals[j * 3 + 1] = (s8)scans[j * scan_len + 8];
+            write_le(scans + j * scan_len + 10, 0xFFFF, 16);
+            vals[j * 3 + 2] = 0xFFFF;
+        }
+
+        if (0 == encode_all(&df, 0x2, scans, vals, lens[i]))
+            return STD_NOT_OK;
+    }
+
+    printf("edge cases round trip\n");
+
+    return STD_OK;
+}
+
+static stdret_t check_zip(const char *name, usize size, u8 level) {
+    const logzip_hdr_t *hdr = (const logzip_hdr_t *)zip_out;
+    usize len = logzip_encodeBlock(zip_raw, size, zip_out, sizeof(zip_out), LOGZIP_LZ4, level);
+    usize raw_len = 0;
+
+    if (0 == len || STD_NOT_OK == logzip_decodeBlock(zip_out, len, zip_back, sizeof(zip_back), &raw_len) ||
+        raw_len != size || 0 != memcmp(zip_raw, zip_back, size)) {
+        fprintf(stderr, "ERROR: %s block of %zu bytes at level %u does not round trip.\n", name, size, level);
+        return STD_NOT_OK;
+    }
+
+    printf("%-10s %6zu B level %u %s %6zu B\n", name, size, level, (LOGZIP_STORED == hdr->method) ? "stored" : "lz4   ",
+           len);
+
+    return STD_OK;
+}
+
+static stdret_t bench_zip(void) {
+    const usize sizes[] = {1, LOGZIP_BLOCK_SIZE - 1, LOGZIP_BLOCK_SIZE};
+    const u8 levels[] = {1, 9};
+    stdret_t ret = STD_OK;
+    usize len = 0;
+
+    for (usize l = 0; l < ARRAY_SIZE(levels); l++) {
+        for (usize i = 0; i < ARRAY_SIZE(sizes); i++) {
+            /* Incompressible, the stored block is expected */
+            for (usize j = 0; j < sizes[i]; j++)
+                zip_raw[j] = (u8)next_rand();
+            if (STD_NOT_OK == check_zip("random", sizes[i], levels[l]))
+                ret = STD_NOT_OK;
+
+            /* A run longer than any LZ4 length byte */
+            memset(zip_raw, 0x5A, sizes[i]);
+            if (STD_NOT_OK == check_zip("run", sizes[i], levels[l]))
+                ret = STD_NOT_OK;
+
+            /* A hexdump log of a slow sensor */
+            for (len = 0; len < sizes[i]; len += (usize)snprintf((char *)zip_raw + len, sizes[i] - len + 1,
+                 "%04x %04x 0000 0000 %08llx 0000 0000\n", 0x9A00U + (u32)(next_rand() % 16U),
+                 0x6400U + (u32)(next_rand() % 8U), (unsigned long long)(next_rand() % 0xFFFFFFFFULL)));
+            if (STD_NOT_OK == check_zip("hexdump", sizes[i], levels[l]))
+                ret = STD_NOT_OK;
+        }
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    usize scan_num = (argc > 1) ? (usize)strtoul(argv[1], NULL, 10) : BENCH_SCANS;
+    int ret = 0;
+
+    if (0 == scan_num) {
+        fprintf(stderr, "ERROR: Nothing to run.\n");
+        return 1;
+    }
+
+    for (usize i = 0; i < ARRAY_SIZE(bench_devs); i++) {
+        if (STD_NOT_OK == bench_dev(&bench_devs[i], scan_num))
+            ret = 1;
+    }
+
+    if (STD_NOT_OK == bench_edges())
+        ret = 1;
+
+    if (STD_NOT_OK == bench_zip())
+        ret = 1;
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
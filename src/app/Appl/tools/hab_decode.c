@@ -0,0 +1,697 @@
+/**********************************************************************************************************************
+* hab_decode.cpp                                                                                                      *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Post-flight decoder. Turns the logs stored by hab_master back into typed values:                              *
+*         - hexdump device logs, the "| <text>" suffix (e.g. wheatstone wiper positions) is kept as a column          *
+*         - framed .dz device logs written by the log codec                                                           *
+*         - framed .lz device logs of raw scan records written by the compression stage                               *
+*         - task_main/dev_readout                                                                                     *
+*       Every input is split into chunks that are decoded on all cores. For an input <log> the tool writes            *
+*       <log>.csv and <log>.col, a typed columnar file: hab_col_hdr_t followed by row_num s64 values of               *
+*       every channel, channel after channel.                                                                         *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_decode [-j <threads>] [-f <bits,bits,...>] [-o <out dir>] <log> ...                                   *
+*           -f  storage bits of the enabled channels of a hexdump or .lz log, 8 x 16 bit words by default             *
+*               an enabled IIO timestamp is the last channel, given as "ts", e.g. -f 16,16,ts                         *
+*                                                                                                                     *
+*       The IIO timestamp column is named "ts", .dz logs flag it in every block.                                      *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "utils.h"
+#include "storage.h"
+#include "iio_scan.h"
+#include "log_codec.h"
+#include "log_zip.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define DECODE_THREAD_MAX   64
+#define DECODE_CHAN_MAX     LOGCODEC_CHAN_MAX
+#define DECODE_CSV_VAL_LEN  24U
+#define DECODE_COL_MAGIC    0x434C4248U /* "HBLC" */
+#define DECODE_READOUT_HDR  "DATA FORMAT"
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    IN_HEX,
+    IN_FRAMED,
+    IN_READOUT,
+} in_type_t;
+
+typedef struct {
+    u32 magic;
+    u32 chan_num;
+    u64 row_num;
+} hab_col_hdr_t;
+
+typedef struct {
+    const char *ptr;
+    usize len;
+} line_append_t;
+
+struct dec_file;
+
+typedef struct {
+    struct dec_file *file;
+    usize start;            /* Byte offset, frame index for framed logs */
+    usize end;
+    u64   first_line;
+    u64   line_num;
+    u8    phase;            /* Channel of the first value of the chunk */
+    s64   *vals;
+    u64   *val_line;
+    usize val_num;
+    u64   first_val;
+    char  *csv;
+    usize csv_len;
+    usize csv_size;
+} chunk_t;
+
+typedef struct dec_file {
+    const u8 *data;
+    usize size;
+    in_type_t type;
+    bool zipped;
+    data_format_t df;
+    u8 chan_num;
+    u64 *frame_off;
+    usize frame_num;
+    line_append_t *appends;
+    line_append_t names[DECODE_CHAN_MAX];
+    chunk_t chunks[DECODE_THREAD_MAX];
+    int chunk_num;
+} dec_file_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static int thread_num;
+static const char *out_dir;
+static data_format_t hex_df = {
+    .chan_num = HEXDUMP_RECORD_LEN / 2,
+    .storagebits = {16, 16, 16, 16, 16, 16, 16, 16},
+};
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static void run_parallel(dec_file_t *file, void *(*fn)(void *)) {
+    pthread_t threads[DECODE_THREAD_MAX];
+
+    for (int i = 0; i < file->chunk_num; i++)
+        pthread_create(&threads[i], NULL, fn, &file->chunks[i]);
+
+    for (int i = 0; i < file->chunk_num; i++)
+        pthread_join(threads[i], NULL);
+}
+
+static const char *next_line(const dec_file_t *file, usize pos, usize end, usize *len) {
+    const char *line = (const char *)file->data + pos;
+    const char *eol = memchr(line, '\n', end - pos);
+
+    *len = (NULL != eol) ? (usize)(eol - line) : end - pos;
+
+    return line;
+}
+
+/* Readout rows are "<ts> <val> ... ", channel legend lines are "<n>) <dev> - <channel>" */
+static bool is_readout_row(const char *line, usize len) {
+    usize i = 0;
+
+    while (i < len && isdigit((unsigned char)line[i]))
+        i++;
+
+    return 0 != i && i < len && ' ' == line[i];
+}
+
+static stdret_t csv_put(chunk_t *chunk, const char *str, usize len) {
+    char *csv = NULL;
+
+    if (chunk->csv_len + len > chunk->csv_size) {
+        chunk->csv_size = max(chunk->csv_size * 2, chunk->csv_len + len + 4096);
+        csv = (char *)realloc(chunk->csv, chunk->csv_size);
+        if (NULL == csv)
+            return STD_NOT_OK;
+        chunk->csv = csv;
+    }
+
+    memcpy(chunk->csv + chunk->csv_len, str, len);
+    chunk->csv_len += len;
+
+    return STD_OK;
+}
+
+/* 1. Line counting, text inputs only */
+static void *count_lines(void *arg) {
+    chunk_t *chunk = (chunk_t *)arg;
+    const u8 *pos = chunk->file->data + chunk->start;
+    const u8 *end = chunk->file->data + chunk->end;
+
+    while (pos < end && NULL != (pos = memchr(pos, '\n', end - pos))) {
+        chunk->line_num++;
+        pos++;
+    }
+
+    /* An unterminated last line of the file */
+    if (chunk->end == chunk->file->size && chunk->end > chunk->start && '\n' != chunk->file->data[chunk->end - 1])
+        chunk->line_num++;
+
+    return NULL;
+}
+
+/* 2. Decoding into values */
+static void *decode_hex(void *arg) {
+    chunk_t *chunk = (chunk_t *)arg;
+    dec_file_t *file = chunk->file;
+    const char *line = NULL;
+    u8 record[HEXDUMP_RECORD_LEN] = {0};
+    u64 line_idx = chunk->first_line;
+    usize len = 0, pos = chunk->start;
+    int val_num = 0;
+
+    chunk->vals = (s64 *)malloc((chunk->line_num + 1) * HEXDUMP_RECORD_LEN * sizeof(s64));
+    chunk->val_line = (u64 *)malloc((chunk->line_num + 1) * HEXDUMP_RECORD_LEN * sizeof(u64));
+    if (NULL == chunk->vals || NULL == chunk->val_line)
+        return NULL;
+
+    for (; pos < chunk->end; pos += len + 1, line_idx++) {
+        line = next_line(file, pos, chunk->end, &len);
+        if (0 != iioscan_parseHexLine(line, len, record, &file->appends[line_idx].ptr, &file->appends[line_idx].len))
+            memset(record, 0, sizeof(record));
+
+        /* A damaged line still advances the channel, the columns stay aligned */
+        val_num = iioscan_extract(&file->df, &chunk->phase, chunk->vals + chunk->val_num, record, sizeof(record));
+        for (int i = 0; i < val_num; i++)
+            chunk->val_line[chunk->val_num++] = line_idx;
+    }
+
+    return NULL;
+}
+
+static void *decode_readout(void *arg) {
+    chunk_t *chunk = (chunk_t *)arg;
+    dec_file_t *file = chunk->file;
+    const char *line = NULL;
+    char *num_end = NULL;
+    s64 row[DECODE_CHAN_MAX] = {0};
+    usize len = 0, pos = chunk->start;
+    u8 col = 0;
+
+    chunk->vals = (s64 *)malloc((chunk->line_num + 1) * file->chan_num * sizeof(s64));
+    if (NULL == chunk->vals)
+        return NULL;
+
+    for (; pos < chunk->end; pos += len + 1) {
+        line = next_line(file, pos, chunk->end, &len);
+        if (!is_readout_row(line, len))
+            continue;
+
+        /* Lines are "<ts> <val> <val> ... ", numbers never run up to the line end */
+        for (col = 0; col < DECODE_CHAN_MAX; col++) {
+            while (line < (const char *)file->data + pos + len && ' ' == *line)
+                line++;
+            if (line >= (const char *)file->data + pos + len)
+                break;
+            row[col] = strtoll(line, &num_end, 10);
+            line = num_end;
+        }
+
+        if (col == file->chan_num) {
+            memcpy(chunk->vals + chunk->val_num, row, col * sizeof(s64));
+            chunk->val_num += col;
+        }
+    }
+
+    return NULL;
+}
+
+static void decode_zipped(chunk_t *chunk, const storage_frame_t *frame, u8 *raw) {
+    usize raw_len = 0;
+
+    if (STD_NOT_OK == logzip_decodeBlock((const u8 *)(frame + 1), frame->len, raw, LOGZIP_BLOCK_SIZE, &raw_len)) {
+        fprintf(stderr, "ERROR: Block of frame %u can not be decompressed, skipped.\n", frame->seq);
+        return;
+    }
+
+    chunk->val_num += iioscan_extract(&chunk->file->df, &chunk->phase, chunk->vals + chunk->val_num, raw, raw_len);
+}
+
+static void *decode_framed(void *arg) {
+    chunk_t *chunk = (chunk_t *)arg;
+    dec_file_t *file = chunk->file;
+    const storage_frame_t *frame = NULL;
+    const u8 *payload = NULL;
+    u8 *raw = NULL;
+    usize used = 0;
+    u8 chan_num = 0, rec_num = 0;
+
+    /* Raw records hold up to one value per byte */
+    if (file->zipped)
+        chunk->vals = (s64 *)malloc((chunk->line_num + 1) * HEXDUMP_RECORD_LEN * sizeof(s64));
+    else
+        chunk->vals = (s64 *)malloc((chunk->end - chunk->start + 1) * LOGCODEC_CHAN_MAX * LOGCODEC_BLOCK_REC * sizeof(s64));
+    raw = (file->zipped) ? (u8 *)malloc(LOGZIP_BLOCK_SIZE) : NULL;
+    if (NULL == chunk->vals || (file->zipped && NULL == raw)) {
+        free(raw);
+        return NULL;
+    }
+
+    for (usize i = chunk->start; i < chunk->end; i++) {
+        frame = (const storage_frame_t *)(file->data + file->frame_off[i]);
+        payload = (const u8 *)(frame + 1);
+
+        if (frame->crc != storage_frameCrc(frame, payload)) {
+            fprintf(stderr, "ERROR: Frame %u is damaged, skipped.\n", frame->seq);
+            continue;
+        }
+
+        if (file->zipped) {
+            decode_zipped(chunk, frame, raw);
+            continue;
+        }
+
+        if (STD_NOT_OK == logcodec_decode(payload, frame->len, &used, chunk->vals + chunk->val_num, &chan_num, &rec_num)) {
+            fprintf(stderr, "ERROR: Block of frame %u can not be decoded, skipped.\n", frame->seq);
+            continue;
+        }
+
+        /* Columns of a reconfigured buffer do not match the rest of the file */
+        if (chan_num != file->chan_num) {
+            fprintf(stderr, "ERROR: Frame %u has %u channels instead of %u, skipped.\n", frame->seq, chan_num, file->chan_num);
+            continue;
+        }
+
+        chunk->val_num += (usize)chan_num * rec_num;
+    }
+
+    free(raw);
+
+    return NULL;
+}
+
+/* 3. CSV formatting */
+static u64 value_line(const dec_file_t *file, u64 val_idx) {
+    for (int i = file->chunk_num - 1; i >= 0; i--) {
+        if (val_idx >= file->chunks[i].first_val)
+            return file->chunks[i].val_line[val_idx - file->chunks[i].first_val];
+    }
+    return 0;
+}
+
+static void *format_csv(void *arg) {
+    chunk_t *chunk = (chunk_t *)arg;
+    dec_file_t *file = chunk->file;
+    const line_append_t *append = NULL;
+    char buff[DECODE_CSV_VAL_LEN] = {0};
+    u64 glob_idx = 0;
+    u32 col = 0;
+    int len = 0;
+
+    for (usize i = 0; i < chunk->val_num; i++) {
+        glob_idx = chunk->first_val + i;
+        col = glob_idx % file->chan_num;
+
+        len = snprintf(buff, sizeof(buff), "%lld%c", (long long)chunk->vals[i],
+                        (col == file->chan_num - 1U) ? '\0' : ',');
+        if (STD_NOT_OK == csv_put(chunk, buff, (col == file->chan_num - 1U) ? (usize)len - 1 : (usize)len))
+            return NULL;
+
+        if (col != file->chan_num - 1U)
+            continue;
+
+        /* The text appended to the line the row starts in */
+        if (NULL != file->appends) {
+            append = &file->appends[value_line(file, glob_idx - col)];
+            csv_put(chunk, ",", 1);
+            if (NULL != append->ptr)
+                csv_put(chunk, append->ptr, append->len);
+        }
+        csv_put(chunk, "\n", 1);
+    }
+
+    return NULL;
+}
+
+static void split_text(dec_file_t *file) {
+    usize chunk_size = file->size / file->chunk_num + 1;
+    usize pos = 0;
+    const u8 *eol = NULL;
+
+    for (int i = 0; i < file->chunk_num; i++) {
+        file->chunks[i].file = file;
+        file->chunks[i].start = pos;
+
+        /* Chunks end on a line boundary */
+        pos = min(pos + chunk_size, file->size);
+        if (pos < file->size) {
+            eol = memchr(file->data + pos, '\n', file->size - pos);
+            pos = (NULL != eol) ? (usize)(eol - file->data) + 1 : file->size;
+        }
+        file->chunks[i].end = pos;
+    }
+}
+
+static stdret_t split_frames(dec_file_t *file) {
+    const storage_frame_t *frame = NULL;
+    usize cap = 1024, pos = 0;
+    usize per_chunk = 0;
+
+    file->frame_off = (u64 *)malloc(cap * sizeof(u64));
+
+    /* Header walk only, CRCs are checked by the workers */
+    while (NULL != file->frame_off && pos + sizeof(*frame) <= file->size) {
+        frame = (const storage_frame_t *)(file->data + pos);
+        if (STORAGE_FRAME_MAGIC != frame->magic || frame->len > file->size - pos - sizeof(*frame))
+            break;
+
+        if (file->frame_num == cap) {
+            cap *= 2;
+            file->frame_off = (u64 *)realloc(file->frame_off, cap * sizeof(u64));
+            if (NULL == file->frame_off)
+                break;
+        }
+        file->frame_off[file->frame_num++] = pos;
+        pos += sizeof(*frame) + frame->len;
+    }
+
+    if (NULL == file->frame_off || 0 == file->frame_num)
+        return STD_NOT_OK;
+
+    /* Channel count of the file is the one of its first block, compressed logs carry raw records */
+    file->zipped = (LOGZIP_MAGIC == file->data[file->frame_off[0] + sizeof(*frame)]);
+    if (!file->zipped) {
+        file->chan_num = file->data[file->frame_off[0] + sizeof(*frame) + 1] & (u8)~LOGCODEC_CHAN_TS;
+        file->df.ts_en = 0 != (file->data[file->frame_off[0] + sizeof(*frame) + 1] & LOGCODEC_CHAN_TS);
+    }
+
+    per_chunk = file->frame_num / file->chunk_num + 1;
+    for (int i = 0; i < file->chunk_num; i++) {
+        file->chunks[i].file = file;
+        file->chunks[i].start = min(i * per_chunk, file->frame_num);
+        file->chunks[i].end = min((i + 1) * per_chunk, file->frame_num);
+
+        /* Records of the chunk, the channel phase of every chunk follows from them */
+        for (usize j = file->chunks[i].start; file->zipped && j < file->chunks[i].end; j++) {
+            frame = (const storage_frame_t *)(file->data + file->frame_off[j]);
+            if (frame->len >= sizeof(logzip_hdr_t))
+                file->chunks[i].line_num += ((const logzip_hdr_t *)(frame + 1))->raw_len / HEXDUMP_RECORD_LEN;
+        }
+    }
+
+    return STD_OK;
+}
+
+static void prepare_hex(dec_file_t *file) {
+    u8 next_phase[DECODE_CHAN_MAX] = {0};
+    u8 record[HEXDUMP_RECORD_LEN] = {0};
+    s64 vals[HEXDUMP_RECORD_LEN] = {0};
+    u64 line_num = 0;
+    u8 phase = 0;
+
+    file->df = hex_df;
+    file->chan_num = hex_df.chan_num;
+
+    /* The channel a line starts with only depends on the channel the previous line started with */
+    for (u8 i = 0; i < file->chan_num; i++) {
+        next_phase[i] = i;
+        (void)iioscan_extract(&file->df, &next_phase[i], vals, record, sizeof(record));
+    }
+
+    for (int i = 0; i < file->chunk_num; i++) {
+        file->chunks[i].first_line = line_num;
+        file->chunks[i].phase = phase;
+        line_num += file->chunks[i].line_num;
+        for (u64 j = 0; j < file->chunks[i].line_num; j++)
+            phase = next_phase[phase];
+    }
+
+    if (IN_HEX == file->type)
+        file->appends = (line_append_t *)calloc(line_num + 1, sizeof(line_append_t));
+}
+
+static void prepare_readout(dec_file_t *file) {
+    const char *line = NULL;
+    const char *name = NULL;
+    usize len = 0;
+    u64 line_num = 0;
+    u32 idx = 0;
+
+    /* Columns of the first data line, named after the legend preceding it */
+    for (usize pos = 0; pos < file->size && 0 == file->chan_num; pos += len + 1) {
+        line = next_line(file, pos, file->size, &len);
+        if (!is_readout_row(line, len)) {
+            name = memchr(line, ')', len);
+            idx = (u32)atoi(line);
+            if (NULL != name && name + 2 <= line + len && idx > 0 && idx < DECODE_CHAN_MAX) {
+                file->names[idx].ptr = name + 2;
+                file->names[idx].len = (usize)(line + len - name - 2);
+            }
+            continue;
+        }
+
+        for (usize i = 0; i < len && file->chan_num < DECODE_CHAN_MAX; i++) {
+            if (' ' != line[i] && (0 == i || ' ' == line[i - 1]))
+                file->chan_num++;
+        }
+    }
+
+    for (int i = 0; i < file->chunk_num; i++) {
+        file->chunks[i].first_line = line_num;
+        line_num += file->chunks[i].line_num;
+    }
+}
+
+static stdret_t write_outputs(const char *in_path, dec_file_t *file) {
+    hab_col_hdr_t hdr = {DECODE_COL_MAGIC, file->chan_num, 0};
+    char base_buff[256] = {0};
+    char path_buff[sizeof(base_buff) + sizeof(".csv")] = {0};
+    char name[64] = {0};
+    FILE *csv = NULL, *col = NULL;
+    u64 val_num = 0;
+
+    snprintf(base_buff, sizeof(base_buff), "%s", in_path);
+    if (NULL != out_dir)
+        snprintf(base_buff, sizeof(base_buff), "%s/%s", out_dir, basename((char *)in_path));
+
+    snprintf(path_buff, sizeof(path_buff), "%s.csv", base_buff);
+    csv = fopen(path_buff, "w");
+    snprintf(path_buff, sizeof(path_buff), "%s.col", base_buff);
+    col = fopen(path_buff, "wb");
+    if (NULL == csv || NULL == col) {
+        fprintf(stderr, "ERROR: Could not create outputs for %s\n", in_path);
+        if (NULL != csv)
+            fclose(csv);
+        if (NULL != col)
+            fclose(col);
+        return STD_NOT_OK;
+    }
+
+    for (u32 i = 0; i < file->chan_num; i++) {
+        if ((IN_READOUT == file->type && 0 == i) || (file->df.ts_en && i == file->chan_num - 1U))
+            snprintf(name, sizeof(name), "%sts", (0 == i) ? "" : ",");
+        else if (IN_READOUT == file->type && NULL != file->names[i].ptr)
+            snprintf(name, sizeof(name), ",%.*s", (int)min(file->names[i].len, sizeof(name) - 2), file->names[i].ptr);
+        else
+            snprintf(name, sizeof(name), "%sch%u", (0 == i) ? "" : ",", i);
+        fputs(name, csv);
+    }
+    fputs((NULL != file->appends) ? ",append\n" : "\n", csv);
+
+    for (int i = 0; i < file->chunk_num; i++) {
+        fwrite(file->chunks[i].csv, 1, file->chunks[i].csv_len, csv);
+        val_num += file->chunks[i].val_num;
+    }
+
+    /* Only complete rows make it to the columnar file */
+    hdr.row_num = val_num / file->chan_num;
+    fwrite(&hdr, sizeof(hdr), 1, col);
+    for (u32 ch = 0; ch < file->chan_num; ch++) {
+        for (int i = 0; i < file->chunk_num; i++) {
+            chunk_t *chunk = &file->chunks[i];
+            for (u64 g = chunk->first_val + (ch + file->chan_num - chunk->first_val % file->chan_num) % file->chan_num;
+                 g < chunk->first_val + chunk->val_num && g / file->chan_num < hdr.row_num; g += file->chan_num)
+                fwrite(&chunk->vals[g - chunk->first_val], sizeof(s64), 1, col);
+        }
+    }
+
+    fclose(csv);
+    fclose(col);
+
+    printf("%s: %llu rows x %u channels\n", in_path, (unsigned long long)hdr.row_num, file->chan_num);
+
+    return STD_OK;
+}
+
+static stdret_t decode_file(const char *path) {
+    stdret_t ret = STD_NOT_OK;
+    struct stat st = {0};
+    dec_file_t *file = NULL;
+    u64 val_num = 0;
+    int fd = -1;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0 || fstat(fd, &st) < 0 || 0 == st.st_size) {
+        fprintf(stderr, "ERROR: Could not read %s\n", path);
+        if (fd >= 0)
+            close(fd);
+        return STD_NOT_OK;
+    }
+
+    file = (dec_file_t *)calloc(1, sizeof(dec_file_t));
+    if (NULL == file) {
+        close(fd);
+        return STD_NOT_OK;
+    }
+
+    file->size = (usize)st.st_size;
+    file->data = (const u8 *)mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == file->data) {
+        free(file);
+        return STD_NOT_OK;
+    }
+    madvise((void *)file->data, file->size, MADV_SEQUENTIAL);
+
+    file->chunk_num = thread_num;
+    if (file->size >= sizeof(u32) && STORAGE_FRAME_MAGIC == *(const u32 *)file->data)
+        file->type = IN_FRAMED;
+    else if (0 == strncmp((const char *)file->data, DECODE_READOUT_HDR, min(file->size, sizeof(DECODE_READOUT_HDR) - 1)))
+        file->type = IN_READOUT;
+    else
+        file->type = IN_HEX;
+
+    if (IN_FRAMED == file->type) {
+        ret = split_frames(file);
+        if (STD_OK == ret && file->zipped)
+            prepare_hex(file);
+        if (STD_OK == ret)
+            run_parallel(file, decode_framed);
+    } else {
+        split_text(file);
+        run_parallel(file, count_lines);
+
+        if (IN_HEX == file->type) {
+            prepare_hex(file);
+            run_parallel(file, decode_hex);
+        } else {
+            prepare_readout(file);
+            if (0 != file->chan_num)
+                run_parallel(file, decode_readout);
+        }
+        ret = (0 != file->chan_num) ? STD_OK : STD_NOT_OK;
+    }
+
+    if (STD_OK == ret) {
+        for (int i = 0; i < file->chunk_num; i++) {
+            file->chunks[i].first_val = val_num;
+            val_num += file->chunks[i].val_num;
+        }
+
+        run_parallel(file, format_csv);
+        ret = write_outputs(path, file);
+    } else {
+        fprintf(stderr, "ERROR: Nothing to decode in %s\n", path);
+    }
+
+    for (int i = 0; i < file->chunk_num; i++) {
+        free(file->chunks[i].vals);
+        free(file->chunks[i].val_line);
+        free(file->chunks[i].csv);
+    }
+    free(file->frame_off);
+    free(file->appends);
+    munmap((void *)file->data, file->size);
+    free(file);
+
+    return ret;
+}
+
+static stdret_t parse_format(char *arg) {
+    char *tok = strtok(arg, ",");
+
+    memset(&hex_df, 0, sizeof(hex_df));
+    while (NULL != tok && hex_df.chan_num < DECODE_CHAN_MAX) {
+        if (hex_df.ts_en)
+            return STD_NOT_OK;
+        hex_df.ts_en = (0 == strcmp(tok, "ts"));
+        hex_df.storagebits[hex_df.chan_num] = hex_df.ts_en ? 64 : (u8)atoi(tok);
+        if (0 == hex_df.storagebits[hex_df.chan_num] || 0 != hex_df.storagebits[hex_df.chan_num] % BYTE)
+            return STD_NOT_OK;
+        hex_df.chan_num++;
+        tok = strtok(NULL, ",");
+    }
+
+    return (0 != hex_df.chan_num) ? STD_OK : STD_NOT_OK;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    int opt = 0;
+    int ret = 0;
+
+    thread_num = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    while (-1 != (opt = getopt(argc, argv, "j:f:o:"))) {
+        switch (opt) {
+        case 'j':
+            thread_num = atoi(optarg);
+            break;
+        case 'f':
+            if (STD_NOT_OK == parse_format(optarg)) {
+                fprintf(stderr, "ERROR: Invalid data format %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'o':
+            out_dir = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-j <threads>] [-f <bits,bits,...>] [-o <out dir>] <log> ...\n", argv[0]);
+            return -1;
+        }
+    }
+
+    thread_num = max(1, min(thread_num, DECODE_THREAD_MAX));
+
+    for (int i = optind; i < argc; i++) {
+        if (STD_NOT_OK == decode_file(argv[i]))
+            ret = -1;
+    }
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
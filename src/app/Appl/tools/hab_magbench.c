@@ -0,0 +1,171 @@
+/**********************************************************************************************************************
+* hab_magbench.cpp                                                                                                    *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Microbenchmark of the accelerometer magnitude threshold used by the free-fall detector.                       *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_magbench [<samples>] [<rounds>]                                                                       *
+*                                                                                                                     *
+*       Times the former per sample mg conversion with isqrt, the scalar kernel and the SIMD kernel of the build      *
+*       on the same data, checks that both kernels return the same mask and prints the cost of one second of          *
+*       samples at the full accel ODR of the ICM20948.                                                                *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "accel_mag.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define BENCH_THR_MG        500U
+#define BENCH_ODR_HZ        1125U
+#define BENCH_SAMPLES       256U
+#define BENCH_ROUNDS        20000U
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef usize (*bench_fn_t)(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask);
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static volatile usize bench_sink;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 now_ns(void) {
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static u32 isqrt(u64 num) {
+    u32 res = 0, tmp = 0;
+    u32 add = 1U << 31;
+    u64 quad;
+
+    while (add > 0) {
+        tmp = res + add;
+        quad = tmp;
+        quad *= tmp;
+        if (num >= quad)
+            res = tmp;
+        add >>= 1;
+    }
+    return res;
+}
+
+/* The conversion the detector did for every sample before the kernel */
+static usize legacy_mask(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask) {
+    const s16 *axis[3] = {x, y, z};
+    usize cnt = 0;
+    u64 accel = 0;
+    s64 tmp = 0;
+
+    (void)thr_sq;
+    memset(mask, 0, ACCMAG_MASK_WORDS(n) * sizeof(u64));
+
+    for (usize i = 0; i < n; i++) {
+        accel = 0;
+        for (u8 a = 0; a < 3; a++) {
+            tmp = (s64)axis[a][i] * 1000L / 16384L;
+            accel += (u64)(tmp * tmp);
+        }
+        if (isqrt(accel) <= BENCH_THR_MG) {
+            mask[i / 64U] |= 1ULL << (i % 64U);
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+static double run(const char *name, bench_fn_t fn, const s16 *x, const s16 *y, const s16 *z,
+                  usize n, u32 rounds, u64 *mask) {
+    u64 start = now_ns();
+    double ns = 0;
+
+    for (u32 r = 0; r < rounds; r++)
+        bench_sink += fn(x, y, z, n, ACCMAG_THR_SQ(BENCH_THR_MG), mask);
+
+    ns = (double)(now_ns() - start) / ((double)rounds * (double)n);
+    printf("%-8s %8.2f ns/sample %10.4f %% of a core at %u Hz\n", name, ns, ns * BENCH_ODR_HZ / 1e7, BENCH_ODR_HZ);
+
+    return ns;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    usize n = (argc > 1) ? strtoul(argv[1], NULL, 10) : BENCH_SAMPLES;
+    u32 rounds = (argc > 2) ? (u32)strtoul(argv[2], NULL, 10) : BENCH_ROUNDS;
+    s16 *x = NULL, *y = NULL, *z = NULL;
+    u64 *ref = NULL, *mask = NULL;
+    usize words = ACCMAG_MASK_WORDS(n);
+    int ret = 0;
+
+    x = (s16 *)malloc(n * sizeof(s16));
+    y = (s16 *)malloc(n * sizeof(s16));
+    z = (s16 *)malloc(n * sizeof(s16));
+    ref = (u64 *)malloc(words * sizeof(u64));
+    mask = (u64 *)malloc(words * sizeof(u64));
+    if (0 == n || 0 == rounds || !x || !y || !z || !ref || !mask) {
+        fprintf(stderr, "ERROR: Nothing to run or out of memory.\n");
+        return 1;
+    }
+
+    /* Noise around 1 g with stretches of free fall, the full range is hit as well */
+    srand(1);
+    for (usize i = 0; i < n; i++) {
+        x[i] = (s16)(rand() % 2001 - 1000);
+        y[i] = (s16)(rand() % 2001 - 1000);
+        z[i] = (s16)(((i / 32U) % 3U) ? (int)ACCMAG_1G_RAW + rand() % 4001 - 2000 : rand() % 8001 - 4000);
+        if (0 == i % 97U)
+            x[i] = y[i] = z[i] = -32768;
+    }
+
+    printf("%zu samples x %u rounds, SIMD kernel: %s\n", n, rounds, accmag_getImpl());
+    run("legacy", legacy_mask, x, y, z, n, rounds, ref);
+    run("scalar", accmag_belowMaskScalar, x, y, z, n, rounds, ref);
+    run("simd", accmag_belowMask, x, y, z, n, rounds, mask);
+
+    if (0 != memcmp(ref, mask, words * sizeof(u64))) {
+        fprintf(stderr, "ERROR: SIMD and scalar masks differ.\n");
+        ret = 1;
+    }
+
+    free(x);
+    free(y);
+    free(z);
+    free(ref);
+    free(mask);
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
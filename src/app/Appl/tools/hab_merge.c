@@ -0,0 +1,313 @@
+/**********************************************************************************************************************
+* hab_merge.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Post-flight tool that k-way merges decoded device tables into one time ordered table.                         *
+*       Inputs are CSV tables with a header line, such as the hab_decode outputs. Every input is streamed line by     *
+*       line and a min-heap picks the source with the earliest pending row, so memory does not depend on the log      *
+*       sizes. Each output row holds the timestamp and the last known value of every input column.                    *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_merge [-r <period>] [-o <out csv>] <csv>[:<ts column>[:<ts scale>]] ...                               *
+*           -r  resample to a fixed period, one row per period instead of one row per timestamp                       *
+*           ts column defaults to the one named "ts", else to 0. ts scale multiplies the timestamps to a common       *
+*           unit, e.g. <csv>:0:1000                                                                                   *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <libgen.h>
+
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define MERGE_SRC_MAX   64
+#define MERGE_COL_MAX   32
+#define MERGE_NAME_LEN  64
+#define MERGE_TS_AUTO   0xFFU
+#define MERGE_TS_NAME   "ts"
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    char *line;
+    usize size;
+    char *field[MERGE_COL_MAX];
+    u8 field_num;
+} merge_row_t;
+
+typedef struct {
+    FILE *filp;
+    char name[MERGE_NAME_LEN];
+    u8 ts_col;
+    s64 ts_scale;
+    u8 col_num;
+    s64 next_ts;
+    merge_row_t next;       /* Pending row, the heap key */
+    merge_row_t last;       /* Last consumed row, held until a newer one arrives */
+    bool has_last;
+} merge_src_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static merge_src_t src_list[MERGE_SRC_MAX];
+static int src_num;
+
+static int heap[MERGE_SRC_MAX];
+static int heap_len;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static void heap_swap(int a, int b) {
+    int tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static bool heap_less(int a, int b) {
+    return src_list[heap[a]].next_ts < src_list[heap[b]].next_ts;
+}
+
+static void heap_push(int src) {
+    int pos = heap_len++;
+
+    heap[pos] = src;
+    for (; pos > 0 && heap_less(pos, (pos - 1) / 2); pos = (pos - 1) / 2)
+        heap_swap(pos, (pos - 1) / 2);
+}
+
+static int heap_pop(void) {
+    int top = heap[0];
+    int pos = 0, child = 0;
+
+    heap[0] = heap[--heap_len];
+    while ((child = 2 * pos + 1) < heap_len) {
+        if (child + 1 < heap_len && heap_less(child + 1, child))
+            child++;
+        if (!heap_less(child, pos))
+            break;
+        heap_swap(pos, child);
+        pos = child;
+    }
+
+    return top;
+}
+
+static void split_row(merge_row_t *row) {
+    char *pos = row->line;
+
+    row->field_num = 0;
+    row->line[strcspn(row->line, "\r\n")] = '\0';
+
+    while (NULL != pos && row->field_num < MERGE_COL_MAX) {
+        row->field[row->field_num++] = pos;
+        pos = strchr(pos, ',');
+        if (NULL != pos)
+            *pos++ = '\0';
+    }
+}
+
+/* Reads the next data row of a source, false at the end of the input */
+static bool read_row(merge_src_t *src) {
+    char *end = NULL;
+
+    while (-1 != getline(&src->next.line, &src->next.size, src->filp)) {
+        split_row(&src->next);
+        if (src->next.field_num <= src->ts_col)
+            continue;
+
+        src->next_ts = strtoll(src->next.field[src->ts_col], &end, 10) * src->ts_scale;
+        if (end != src->next.field[src->ts_col])
+            return true;
+    }
+
+    return false;
+}
+
+static void consume(merge_src_t *src) {
+    merge_row_t tmp = src->last;
+
+    src->last = src->next;
+    src->next = tmp;
+    src->has_last = true;
+
+    if (read_row(src))
+        heap_push((int)(src - src_list));
+}
+
+static void write_header(FILE *out) {
+    merge_row_t hdr = {0};
+
+    fputs("ts", out);
+    for (int i = 0; i < src_num; i++) {
+        if (-1 == getline(&hdr.line, &hdr.size, src_list[i].filp))
+            continue;
+        split_row(&hdr);
+
+        /* hab_decode names the IIO timestamp column, its position depends on the channels of the device */
+        for (u8 col = 0; MERGE_TS_AUTO == src_list[i].ts_col && col < hdr.field_num; col++) {
+            if (0 == strcmp(hdr.field[col], MERGE_TS_NAME))
+                src_list[i].ts_col = col;
+        }
+        if (MERGE_TS_AUTO == src_list[i].ts_col)
+            src_list[i].ts_col = 0;
+
+        src_list[i].col_num = hdr.field_num;
+        for (u8 col = 0; col < hdr.field_num; col++) {
+            if (col != src_list[i].ts_col)
+                fprintf(out, ",%s.%s", src_list[i].name, hdr.field[col]);
+        }
+    }
+    fputc('\n', out);
+
+    free(hdr.line);
+}
+
+static void write_row(FILE *out, s64 ts) {
+    const merge_src_t *src = NULL;
+
+    fprintf(out, "%lld", (long long)ts);
+    for (int i = 0; i < src_num; i++) {
+        src = &src_list[i];
+        for (u8 col = 0; col < src->col_num; col++) {
+            if (col == src->ts_col)
+                continue;
+            fputc(',', out);
+            if (src->has_last && col < src->last.field_num)
+                fputs(src->last.field[col], out);
+        }
+    }
+    fputc('\n', out);
+}
+
+static stdret_t open_source(merge_src_t *src, char *spec) {
+    char *opt = strchr(spec, ':');
+    char *dot = NULL;
+
+    src->ts_scale = 1;
+    src->ts_col = MERGE_TS_AUTO;
+    if (NULL != opt) {
+        *opt++ = '\0';
+        src->ts_col = (u8)atoi(opt);
+        opt = strchr(opt, ':');
+        if (NULL != opt)
+            src->ts_scale = strtoll(opt + 1, NULL, 10);
+    }
+
+    src->filp = fopen(spec, "r");
+    if (NULL == src->filp) {
+        fprintf(stderr, "ERROR: Could not open %s\n", spec);
+        return STD_NOT_OK;
+    }
+
+    /* Columns are prefixed with the file name without its extension */
+    snprintf(src->name, sizeof(src->name), "%s", basename(spec));
+    dot = strchr(src->name, '.');
+    if (NULL != dot)
+        *dot = '\0';
+
+    return STD_OK;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    FILE *out = stdout;
+    s64 period = 0, grid = 0, ts = 0;
+    bool any = false;
+    int opt = 0;
+
+    while (-1 != (opt = getopt(argc, argv, "r:o:"))) {
+        switch (opt) {
+        case 'r':
+            period = strtoll(optarg, NULL, 10);
+            break;
+        case 'o':
+            out = fopen(optarg, "w");
+            if (NULL == out) {
+                fprintf(stderr, "ERROR: Could not create %s\n", optarg);
+                return -1;
+            }
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-r <period>] [-o <out csv>] <csv>[:<ts column>[:<ts scale>]] ...\n", argv[0]);
+            return -1;
+        }
+    }
+
+    for (int i = optind; i < argc && src_num < MERGE_SRC_MAX; i++) {
+        if (STD_NOT_OK == open_source(&src_list[src_num], argv[i]))
+            return -1;
+        src_num++;
+    }
+
+    write_header(out);
+    for (int i = 0; i < src_num; i++) {
+        if (read_row(&src_list[i]))
+            heap_push(i);
+    }
+
+    any = (0 != heap_len);
+    if (any && period > 0)
+        grid = src_list[heap[0]].next_ts + (period - src_list[heap[0]].next_ts % period) % period;
+
+    while (0 != heap_len) {
+        ts = src_list[heap[0]].next_ts;
+
+        if (period > 0) {
+            /* A grid point is written once every row up to it is consumed */
+            if (ts <= grid) {
+                consume(&src_list[heap_pop()]);
+            } else {
+                write_row(out, grid);
+                grid += period;
+            }
+            continue;
+        }
+
+        /* Rows sharing a timestamp are folded into one */
+        while (0 != heap_len && src_list[heap[0]].next_ts == ts)
+            consume(&src_list[heap_pop()]);
+        write_row(out, ts);
+    }
+
+    if (any && period > 0)
+        write_row(out, grid);
+
+    for (int i = 0; i < src_num; i++) {
+        fclose(src_list[i].filp);
+        free(src_list[i].next.line);
+        free(src_list[i].last.line);
+    }
+
+    if (stdout != out)
+        fclose(out);
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
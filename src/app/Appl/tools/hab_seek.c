@@ -0,0 +1,153 @@
+/**********************************************************************************************************************
+* hab_seek.cpp                                                                                                        *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Post-flight tool that cuts a time range out of a log using its sidecar index.                                 *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_seek <log path> -l                                  - print the index entries                         *
+*           hab_seek <log path> [<run>:]<from ms> [[<run>:]<to ms>] - write the log data of the range to stdout       *
+*                                                                                                                     *
+*       The range is widened to the index entries around it, so it holds every record of [from, to]. Times are        *
+*       on the clock of the records, a run counts the restarts of hab_master that resumed the log, 0 by default.      *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "storage.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define COPY_BUFF_LEN  65536U
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static int print_index(const char *path) {
+    storage_idx_t entry = {0};
+    char idx_path[80] = {0};
+    FILE *filp = NULL;
+
+    snprintf(idx_path, sizeof(idx_path), "%s%s", path, STORAGE_IDX_EXT);
+    filp = fopen(idx_path, "rb");
+    if (NULL == filp) {
+        fprintf(stderr, "ERROR: Could not open %s\n", idx_path);
+        return -1;
+    }
+
+    printf("%-6s %-16s %-8s %s\n", "run", "ts_ms", "segment", "offset");
+    while (1 == fread(&entry, sizeof(entry), 1, filp))
+        printf("%-6u %-16llu %-8u %llu\n", entry.run, (unsigned long long)entry.ts_ms, entry.seg_seq,
+               (unsigned long long)entry.offset);
+
+    fclose(filp);
+
+    return 0;
+}
+
+/* "<run>:<ms>" or "<ms>" of the first run */
+static stdret_t seek_arg(const char *path, const char *arg, const bool upper, storage_idx_t *pos) {
+    char *end = NULL;
+    u64 val = strtoull(arg, &end, 10);
+
+    if (':' == *end)
+        return storage_seek(path, (u32)val, strtoull(end + 1, NULL, 10), upper, pos);
+
+    return storage_seek(path, 0, val, upper, pos);
+}
+
+static stdret_t copy_file(const char *file, u64 from, u64 to) {
+    static char buff[COPY_BUFF_LEN];
+    FILE *filp = NULL;
+    usize len = 0;
+
+    filp = fopen(file, "rb");
+    if (NULL == filp || 0 != fseek(filp, (long)from, SEEK_SET)) {
+        fprintf(stderr, "ERROR: Could not read %s\n", file);
+        if (NULL != filp)
+            fclose(filp);
+        return STD_NOT_OK;
+    }
+
+    while (from < to && (len = fread(buff, 1, (usize)(to - from < sizeof(buff) ? to - from : sizeof(buff)), filp)) > 0) {
+        fwrite(buff, 1, len, stdout);
+        from += len;
+    }
+
+    fclose(filp);
+
+    return STD_OK;
+}
+
+static int copy_range(const char *path, const storage_idx_t *start, const storage_idx_t *end, const bool bounded) {
+    struct stat st = {0};
+    char file[96] = {0};
+    u64 from = 0, to = 0;
+
+    for (u32 seq = start->seg_seq; !bounded || seq <= end->seg_seq; seq++) {
+        storage_getFilePath(path, seq, file, sizeof(file));
+        if (0 != stat(file, &st))
+            break;
+
+        from = (seq == start->seg_seq) ? start->offset : 0;
+        to = (bounded && seq == end->seg_seq) ? end->offset : (u64)st.st_size;
+
+        if (STD_NOT_OK == copy_file(file, from, to))
+            return -1;
+
+        /* A stream log is a single file */
+        if (0 == strcmp(file, path))
+            break;
+    }
+
+    return 0;
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    storage_idx_t start = {0};
+    storage_idx_t end = {0};
+    bool bounded = false;
+
+    if (argc == 3 && 0 == strcmp(argv[2], "-l"))
+        return print_index(argv[1]);
+
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <log path> -l | [<run>:]<from ms> [[<run>:]<to ms>]\n", argv[0]);
+        return -1;
+    }
+
+    if (STD_NOT_OK == seek_arg(argv[1], argv[2], false, &start)) {
+        fprintf(stderr, "ERROR: No index for %s\n", argv[1]);
+        return -1;
+    }
+
+    if (argc > 3)
+        bounded = (STD_OK == seek_arg(argv[1], argv[3], true, &end));
+
+    return copy_range(argv[1], &start, &end, bounded);
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+* hab_telem.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Live monitor of the telemetry segment published by a running hab_master.                                      *
+*                                                                                                                     *
+*       USAGE :                                                                                                       *
+*           hab_telem                                   - print one snapshot of every device                          *
+*           hab_telem <period ms> [<count>]             - print a snapshot every period, count times or forever       *
+*                                                                                                                     *
+*       A line holds the device, the age of its last update and value/status pairs of its channels in the units of    *
+*       the IIO ABI, status is '!' for a failed readout and '-' for a channel without data.                           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define NS_IN_MS  1000000ULL
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u64 now_ns(void) {
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (u64)ts.tv_sec * 1000000000ULL + (u64)ts.tv_nsec;
+}
+
+static char status_mark(const u32 status) {
+    switch (status) {
+    case TELEM_OK:
+        return ' ';
+    case TELEM_ERROR:
+        return '!';
+    default:
+        return '-';
+    }
+}
+
+static void print_snapshot(const telem_hdr_t *hdr) {
+    telem_dev_t dev = {0};
+    u64 now = now_ns();
+
+    for (u16 i = 0; i < hdr->dev_num; i++) {
+        if (STD_NOT_OK == telem_snapshot(hdr, (u8)i, &dev)) {
+            printf("%-16s busy\n", TELEM_DEV(hdr, i)->name);
+            continue;
+        }
+        if (0 == dev.update_cnt)
+            continue;
+
+        printf("%-16s %8llu ms ", dev.name, (unsigned long long)((now - dev.update_ns) / NS_IN_MS));
+        for (u8 ch = 0; ch < dev.chan_num && ch < TELEM_CHAN_MAX; ch++)
+            printf(" %g%c", dev.chan[ch].si, status_mark(dev.chan[ch].status));
+        printf("\n");
+    }
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+int main(int argc, char **argv) {
+    const telem_hdr_t *hdr = NULL;
+    unsigned long period_ms = 0;
+    long count = 1;
+
+    if (argc > 1) {
+        period_ms = strtoul(argv[1], NULL, 10);
+        count = (argc > 2) ? strtol(argv[2], NULL, 10) : -1;
+    }
+
+    hdr = telem_attach();
+    if (NULL == hdr) {
+        fprintf(stderr, "ERROR: Could not attach %s, is hab_master running?\n", TELEM_SHM_NAME);
+        return 1;
+    }
+
+    for (long i = 0; count < 0 || i < count; i++) {
+        if (0 != i)
+            usleep(period_ms * 1000U);
+        printf("--- pid %u, up %llu s\n", hdr->pid, (unsigned long long)((now_ns() - hdr->start_ns) / (NS_IN_MS * 1000U)));
+        print_snapshot(hdr);
+        fflush(stdout);
+    }
+
+    return 0;
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
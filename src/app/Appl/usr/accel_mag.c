@@ -0,0 +1,164 @@
+/**********************************************************************************************************************
+* accel_mag.cpp                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Batch threshold of the accelerometer magnitude. The squared magnitude of 16 bit axes is below 3 * 2^30,       *
+*       so it is exact in unsigned 32 bit arithmetic and no square root or division is needed per sample.             *
+*       SSE2 and NEON handle 8 samples per step, the tail and other targets use the scalar loop.                      *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       usize               accmag_belowMask(const s16 *x, const s16 *y, const s16 *z, usize n, ...)                  *
+*       usize               accmag_belowMaskScalar(...)                                                               *
+*       const char *        accmag_getImpl(void)                                                                      *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <string.h>
+
+#include "accel_mag.h"
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+# define ACCMAG_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define ACCMAG_NEON
+#endif
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define ACCMAG_LANES    8U
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static u32 mag_sq(const s16 x, const s16 y, const s16 z) {
+    /* Every square fits s32, the sum wraps to the exact unsigned value */
+    return (u32)((s32)x * x) + (u32)((s32)y * y) + (u32)((s32)z * z);
+}
+
+static void scalar_range(const s16 *x, const s16 *y, const s16 *z, usize from, usize n, u32 thr_sq, u64 *mask) {
+    for (usize i = from; i < n; i++) {
+        if (mag_sq(x[i], y[i], z[i]) <= thr_sq)
+            mask[i / 64U] |= 1ULL << (i % 64U);
+    }
+}
+
+static usize count_bits(const u64 *mask, usize n) {
+    usize cnt = 0;
+
+    for (usize i = 0; i < ACCMAG_MASK_WORDS(n); i++)
+        cnt += (usize)__builtin_popcountll(mask[i]);
+
+    return cnt;
+}
+
+#if defined(ACCMAG_SSE2)
+/* x^2 + y^2 of each pair comes from madd on the interleaved axes, z is paired with zero */
+static u32 sse2_below8(const s16 *x, const s16 *y, const s16 *z, const __m128i thr) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sign = _mm_set1_epi32((int)0x80000000U);
+    __m128i vx = _mm_loadu_si128((const __m128i *)x);
+    __m128i vy = _mm_loadu_si128((const __m128i *)y);
+    __m128i vz = _mm_loadu_si128((const __m128i *)z);
+    __m128i xy = _mm_unpacklo_epi16(vx, vy);
+    __m128i zz = _mm_unpacklo_epi16(vz, zero);
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(xy, xy), _mm_madd_epi16(zz, zz));
+    __m128i hi;
+
+    xy = _mm_unpackhi_epi16(vx, vy);
+    zz = _mm_unpackhi_epi16(vz, zero);
+    hi = _mm_add_epi32(_mm_madd_epi16(xy, xy), _mm_madd_epi16(zz, zz));
+
+    /* SSE2 has no unsigned compare, both sides are biased by the sign bit */
+    lo = _mm_cmpgt_epi32(_mm_xor_si128(lo, sign), thr);
+    hi = _mm_cmpgt_epi32(_mm_xor_si128(hi, sign), thr);
+
+    return ~((u32)_mm_movemask_ps(_mm_castsi128_ps(lo)) | ((u32)_mm_movemask_ps(_mm_castsi128_ps(hi)) << 4)) & 0xFFU;
+}
+#elif defined(ACCMAG_NEON)
+static u32 neon_bits4(const uint32x4_t cmp) {
+    static const uint32_t weight[4] = {1U, 2U, 4U, 8U};
+    uint32x4_t bits = vandq_u32(cmp, vld1q_u32(weight));
+    uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+
+    sum = vpadd_u32(sum, sum);
+
+    return vget_lane_u32(sum, 0);
+}
+
+static u32 neon_below8(const s16 *x, const s16 *y, const s16 *z, const uint32x4_t thr) {
+    int16x8_t vx = vld1q_s16(x);
+    int16x8_t vy = vld1q_s16(y);
+    int16x8_t vz = vld1q_s16(z);
+    int32x4_t lo = vmull_s16(vget_low_s16(vx), vget_low_s16(vx));
+    int32x4_t hi = vmull_s16(vget_high_s16(vx), vget_high_s16(vx));
+
+    lo = vmlal_s16(lo, vget_low_s16(vy), vget_low_s16(vy));
+    lo = vmlal_s16(lo, vget_low_s16(vz), vget_low_s16(vz));
+    hi = vmlal_s16(hi, vget_high_s16(vy), vget_high_s16(vy));
+    hi = vmlal_s16(hi, vget_high_s16(vz), vget_high_s16(vz));
+
+    return neon_bits4(vcleq_u32(vreinterpretq_u32_s32(lo), thr)) |
+           (neon_bits4(vcleq_u32(vreinterpretq_u32_s32(hi), thr)) << 4);
+}
+#endif
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+usize accmag_belowMaskScalar(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask) {
+    memset(mask, 0, ACCMAG_MASK_WORDS(n) * sizeof(u64));
+    scalar_range(x, y, z, 0, n, thr_sq, mask);
+
+    return count_bits(mask, n);
+}
+
+usize accmag_belowMask(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask) {
+    usize i = 0;
+
+    memset(mask, 0, ACCMAG_MASK_WORDS(n) * sizeof(u64));
+
+#if defined(ACCMAG_SSE2)
+    const __m128i thr = _mm_set1_epi32((int)(thr_sq ^ 0x80000000U));
+
+    for (; i + ACCMAG_LANES <= n; i += ACCMAG_LANES)
+        mask[i / 64U] |= (u64)sse2_below8(x + i, y + i, z + i, thr) << (i % 64U);
+#elif defined(ACCMAG_NEON)
+    const uint32x4_t thr = vdupq_n_u32(thr_sq);
+
+    for (; i + ACCMAG_LANES <= n; i += ACCMAG_LANES)
+        mask[i / 64U] |= (u64)neon_below8(x + i, y + i, z + i, thr) << (i % 64U);
+#endif
+
+    scalar_range(x, y, z, i, n, thr_sq, mask);
+
+    return count_bits(mask, n);
+}
+
+const char *accmag_getImpl(void) {
+#if defined(ACCMAG_SSE2)
+    return "sse2";
+#elif defined(ACCMAG_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
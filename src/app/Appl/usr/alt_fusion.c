@@ -0,0 +1,272 @@
+/**********************************************************************************************************************
+* alt_fusion.cpp                                                                                                      *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Altitude and climb rate of the payload. The pressure is turned into a barometric altitude by a table of       *
+*       the ISA layers up to 47 km, built once at startup and interpolated per sample. The vertical acceleration      *
+*       is the IMU specific force along a low-passed gravity vector. Both are fused by a third order                  *
+*       complementary filter in integer micro units: every IMU scan integrates velocity and altitude, every           *
+*       pressure scan corrects altitude, velocity and the accelerometer bias with gains of the time constant.         *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            altfus_init(void);                                                                        *
+*       s32                 altfus_pressureToAlt(u32 p_q8);                                                           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "utils.h"
+#include "event.h"
+#include "hab_device.h"
+#include "accel_mag.h"
+#include "alt_fusion.h"
+
+#if (defined IIO_KMOD_IDX_MPRLS0025) && (defined IIO_KMOD_IDX_ICM20948)
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+/* Time constant of the baro correction, s. Shorter follows the baro noise, longer the accelerometer drift. */
+#define ALTFUS_TAU_S            10LL
+/* Longest step taken into the integration, above the sample period of both sensors. A gap of the stream
+ * is not integrated across. */
+#define ALTFUS_DT_MAX_US        10000000LL
+/* The gravity vector follows the accel over 2^shift scans */
+#define ALTFUS_GRAV_SHIFT       8
+/* Below half a g the gravity direction is lost, e.g. in free fall, and the baro is used alone */
+#define ALTFUS_GRAV_MIN_MS2     (9.80665 / 2.0)
+
+#define ALTFUS_G_UM             9806650LL
+#define ALTFUS_US               1000000LL
+/* Converted pressure is in kPa, the table takes Pa with 8 fractional bits */
+#define ALTFUS_KPA_TO_Q8        256000.0
+
+/**********************************************************************************************************************
+ * LOCAL TYPEDEFS DECLARATION
+ *********************************************************************************************************************/
+/* Base of an ISA layer, altitude m, temperature K, pressure Pa and lapse rate K/m */
+typedef struct {
+    double h;
+    double t;
+    double p;
+    double lapse;
+} isa_layer_t;
+
+typedef struct {
+    s64 grav_min_sq;
+    bool baro_set;
+    s32 baro_mm;
+    u64 baro_ns;
+    u64 imu_ns;
+    bool grav_set;
+    s32 grav[3];
+    s64 h_um;
+    s64 v_ums;
+    s64 bias_ums2;
+} altfus_t;
+
+/**********************************************************************************************************************
+ * GLOBAL VARIABLES DECLARATION
+ *********************************************************************************************************************/
+static const isa_layer_t isa_layers[] = {
+    {0.0,     288.15, 101325.0,  -0.0065},
+    {11000.0, 216.65, 22632.06,  0.0},
+    {20000.0, 216.65, 5474.889,  0.001},
+    {32000.0, 228.65, 868.0187,  0.0028},
+    {47000.0, 270.65, 110.9063,  0.0},
+};
+
+/* Descending pressures, Pa with 8 fractional bits, and their altitudes in mm */
+static u32 lut_p[ALTFUS_LUT_LEN];
+static s32 lut_alt[ALTFUS_LUT_LEN];
+
+static altfus_t fus;
+
+/**********************************************************************************************************************
+ * LOCAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+static double isa_alt(double p) {
+    const double r_air = 287.053, g0 = 9.80665;
+    const isa_layer_t *layer = &isa_layers[0];
+
+    for (usize i = 1; i < ARRAY_SIZE(isa_layers) && p < isa_layers[i].p; i++)
+        layer = &isa_layers[i];
+
+    if (0.0 == layer->lapse)
+        return layer->h - r_air * layer->t / g0 * log(p / layer->p);
+
+    return layer->h + layer->t / layer->lapse * (pow(p / layer->p, -r_air * layer->lapse / g0) - 1.0);
+}
+
+static void publish(u64 ts) {
+    ev_msg_t msg = {0};
+
+    msg.topic = EV_TOPIC_ALTITUDE;
+    msg.ts_ns = ts;
+    msg.data.altitude.alt_mm = (s32)(fus.h_um / 1000);
+    msg.data.altitude.climb_mms = (s32)(fus.v_ums / 1000);
+    msg.data.altitude.baro_mm = fus.baro_mm;
+
+    event_publish(&msg);
+}
+
+static s64 step_us(u64 *last_ns, u64 ts) {
+    s64 dt_us = 0;
+
+    if (0 != *last_ns && ts > *last_ns)
+        dt_us = min((s64)((ts - *last_ns) / 1000U), ALTFUS_DT_MAX_US);
+    *last_ns = ts;
+
+    return dt_us;
+}
+
+static void imu_step(const s64 *scan, u64 ts) {
+    s32 acc[3] = {(s16)scan[0], (s16)scan[1], (s16)scan[2]};
+    s64 dot = 0, grav_sq = 0, acc_ums2 = 0;
+    s64 dt_us = step_us(&fus.imu_ns, ts);
+    s32 grav = 0;
+
+    for (u8 i = 0; i < 3; i++) {
+        if (!fus.grav_set)
+            fus.grav[i] = acc[i] << ALTFUS_GRAV_SHIFT;
+        fus.grav[i] += acc[i] - (fus.grav[i] >> ALTFUS_GRAV_SHIFT);
+
+        grav = fus.grav[i] >> ALTFUS_GRAV_SHIFT;
+        dot += (s64)acc[i] * grav;
+        grav_sq += (s64)grav * grav;
+    }
+    fus.grav_set = true;
+
+    if (!fus.baro_set || 0 == dt_us)
+        return;
+
+    /* Specific force along gravity less 1 g, in g it is (a.g - |g|^2) / |g|^2 */
+    if (grav_sq >= fus.grav_min_sq)
+        acc_ums2 = (dot - grav_sq) * ALTFUS_G_UM / grav_sq;
+
+    fus.v_ums += (acc_ums2 - fus.bias_ums2) * dt_us / ALTFUS_US;
+    fus.h_um += fus.v_ums * dt_us / ALTFUS_US;
+}
+
+static void baro_step(double p_kpa, u64 ts) {
+    s64 dt_us = 0, err = 0;
+
+    fus.baro_mm = altfus_pressureToAlt((u32)llround(fmax(p_kpa * ALTFUS_KPA_TO_Q8, 0.0)));
+
+    if (!fus.baro_set) {
+        fus.baro_set = true;
+        fus.baro_ns = ts;
+        fus.h_um = (s64)fus.baro_mm * 1000;
+        return;
+    }
+
+    dt_us = step_us(&fus.baro_ns, ts);
+    err = (s64)fus.baro_mm * 1000 - fus.h_um;
+
+    /* Gains 3 / tau, 3 / tau^2 and 1 / tau^3 of the continuous filter, times the step */
+    fus.h_um += 3 * err * dt_us / (ALTFUS_TAU_S * ALTFUS_US);
+    fus.v_ums += 3 * err * dt_us / (ALTFUS_TAU_S * ALTFUS_TAU_S * ALTFUS_US);
+    fus.bias_ums2 -= err * dt_us / (ALTFUS_TAU_S * ALTFUS_TAU_S * ALTFUS_TAU_S * ALTFUS_US);
+}
+
+static void on_scan(const ev_msg_t *msg, void *ctx) {
+    const struct scan *scan = &msg->data.scan;
+    u8 chan_num = scan->chan_num - (scan->ts_en ? 1U : 0U);
+    const habdev_t *habdev = habdev_get(scan->dev_idx);
+    const s64 *vals = NULL;
+    double grav_min = 0;
+    u64 ts = msg->ts_ns;
+
+    (void)ctx;
+
+    if (IIO_KMOD_IDX_ICM20948 == scan->dev_idx && chan_num >= 3 && NULL != habdev) {
+        /* The filter runs on the raw axes, only the gravity gate depends on the range. Without a scale
+         * attribute the axes are taken as counts of the +-2 g range. */
+        grav_min = habdev->conv.chan[0].scaled ? ALTFUS_GRAV_MIN_MS2 / habdev->conv.chan[0].scale :
+                                                 ACCMAG_1G_RAW / 2.0;
+        fus.grav_min_sq = (s64)(grav_min * grav_min);
+        for (u32 i = 0; i + scan->chan_num <= scan->val_num; i += scan->chan_num) {
+            vals = scan->vals + i;
+            imu_step(vals, scan->ts_en ? (u64)vals[chan_num] : ts);
+        }
+    } else if (IIO_KMOD_IDX_MPRLS0025 == scan->dev_idx && chan_num >= 1) {
+        for (u32 i = 0; i + scan->chan_num <= scan->val_num; i += scan->chan_num) {
+            vals = scan->vals + i;
+            baro_step(scan->si[i], scan->ts_en ? (u64)vals[chan_num] : ts);
+        }
+    } else {
+        return;
+    }
+
+    if (fus.baro_set)
+        publish(fus.imu_ns > fus.baro_ns ? fus.imu_ns : fus.baro_ns);
+}
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DEFINITION
+ *********************************************************************************************************************/
+stdret_t altfus_init(void) {
+    double ratio = pow((double)ALTFUS_P_MIN_PA / ALTFUS_P_MAX_PA, 1.0 / (ALTFUS_LUT_LEN - 1U));
+    double p = ALTFUS_P_MAX_PA;
+
+    /* Geometric steps keep the interpolation error below a metre over the whole range */
+    for (u32 i = 0; i < ALTFUS_LUT_LEN; i++, p *= ratio) {
+        lut_p[i] = (u32)llround(p * 256.0);
+        lut_alt[i] = (s32)llround(isa_alt(lut_p[i] / 256.0) * 1000.0);
+    }
+
+    memset(&fus, 0, sizeof(fus));
+
+    return event_subscribe(EV_TOPIC_SCAN, on_scan, NULL);
+}
+
+s32 altfus_pressureToAlt(u32 p_q8) {
+    u32 lo = 0, hi = ALTFUS_LUT_LEN - 1U, mid = 0;
+
+    if (p_q8 >= lut_p[0])
+        return lut_alt[0];
+    if (p_q8 <= lut_p[ALTFUS_LUT_LEN - 1U])
+        return lut_alt[ALTFUS_LUT_LEN - 1U];
+
+    while (hi - lo > 1U) {
+        mid = (lo + hi) / 2U;
+        if (lut_p[mid] > p_q8)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lut_alt[lo] + (s32)((s64)(lut_alt[hi] - lut_alt[lo]) * (lut_p[lo] - p_q8) / (lut_p[lo] - lut_p[hi]));
+}
+
+#else
+
+stdret_t altfus_init(void) {
+    return STD_NOT_OK;
+}
+
+s32 altfus_pressureToAlt(u32 p_q8) {
+    (void)p_q8;
+    return 0;
+}
+
+#endif
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -1,9 +1,13 @@
 #include <time.h>
+#include <sys/stat.h>
 #include <stdlib.h>
 #include <string.h>
 #include <uv.h>
 
 #include "camera.h"
+#include "storage_budget.h"
+#include "storage_shaper.h"
+#include "hab_time.h"
 
 /* FIX TO PATH STORAGE */
 #include "utils.h"
@@ -31,19 +35,18 @@ typedef enum {
 } media_t;
 
 static void get_output_name(media_t media, const char *cam_tag, char *buffer, usize size) {
-    struct timespec tim;
+    unsigned long long ts = (unsigned long long)habtime_nowNs();
 
     memset(buffer, 0, size);
-    clock_gettime(CLOCK_MONOTONIC, &tim);
 
     switch (media) {
     case CAM_STILL:
         snprintf(buffer, size, "%s%s/%s-%s-%llu%s", 
-            HAB_DATASTORAGE_PATH, MEDIA_PHOTOS, cam_tag, STILL_BASENAME, (unsigned long long)tim.tv_sec, STILL_FORMAT);
+            HAB_DATASTORAGE_PATH, MEDIA_PHOTOS, cam_tag, STILL_BASENAME, ts, STILL_FORMAT);
         break;
     case CAM_VIDEO:
         snprintf(buffer, size, "%s%s/%s-%s-%llu%s", 
-            HAB_DATASTORAGE_PATH, MEDIA_VIDEOS, cam_tag, VIDEO_BASENAME, (unsigned long long)tim.tv_sec, VIDEO_FORMAT);
+            HAB_DATASTORAGE_PATH, MEDIA_VIDEOS, cam_tag, VIDEO_BASENAME, ts, VIDEO_FORMAT);
         break;
     default:
         break;
@@ -52,7 +55,11 @@ static void get_output_name(media_t media, const char *cam_tag, char *buffer, us
 
 void camera_run(uv_work_t *req) {
     habdev_t *habdev = (habdev_t *)req->data;
+    struct stat st = {0};
     u8 op = 0;
+    u8 quality = 0;
+    int ioprio = -1;
+    budget_class_t cls = BUDGET_STILL;
     char output_path[128] = {0};
     char action_cmd[256] = {0};
     int curr_idx = 0;
@@ -64,6 +71,13 @@ void camera_run(uv_work_t *req) {
     if (NULL != habdev->path.channel[CAMERA_VIDEO_CMD])
         dev_counters[curr_idx]--;
 
+    /* A video slot the storage budget or the I/O shaper can not afford falls back to a still */
+    if (dev_counters[curr_idx] <= 0 && (!budget_allowMedia(BUDGET_VIDEO) || !shaper_acquire(BUDGET_VIDEO)))
+        dev_counters[curr_idx] = VIDEO_COUNTDOWN;
+
+    if (!budget_allowMedia(BUDGET_STILL) || (dev_counters[curr_idx] > 0 && !shaper_acquire(BUDGET_STILL)))
+        return;
+
     if (dev_counters[curr_idx] > 0) {
         get_output_name(CAM_STILL, habdev->path.dev_name, output_path, sizeof(output_path));
         op = CAMERA_STILL_CMD;
@@ -75,5 +89,18 @@ void camera_run(uv_work_t *req) {
 
     snprintf(action_cmd, sizeof(action_cmd), "%s %s", habdev->path.channel[op], output_path);
 
+    quality = budget_getStillQuality();
+    if (CAMERA_STILL_CMD == op && 0 != quality)
+        snprintf(action_cmd + strlen(action_cmd), sizeof(action_cmd) - strlen(action_cmd), " --quality %u", quality);
+
+    /* The rpicam child inherits the I/O priority of this worker thread */
+    cls = (CAMERA_STILL_CMD == op) ? BUDGET_STILL : BUDGET_VIDEO;
+    ioprio = shaper_setThreadClass(cls);
     system(action_cmd);
+    shaper_restoreThread(ioprio);
+
+    if (0 == stat(output_path, &st)) {
+        budget_account(cls, (usize)st.st_size);
+        shaper_consume(cls, (usize)st.st_size);
+    }
 }
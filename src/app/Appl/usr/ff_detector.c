@@ -2,6 +2,7 @@
 /**********************************************************************************************************************
  *  INCLUDES
  *********************************************************************************************************************/
+#include <math.h>
 #include <string.h>
 #include <stdbool.h>
 
@@ -9,6 +10,9 @@
 #include "iio_buffer_ops.h"
 #include "stdtypes.h"
 #include "utils.h"
+#include "event.h"
+#include "hab_time.h"
+#include "accel_mag.h"
 
 /**********************************************************************************************************************
  *  PREPROCESSOR DEFINITIONS
@@ -23,48 +27,48 @@
 #define PREFLIGHT_DEBOUNCE -1
 
 #define ACCEL_MG_SCALE 1000
-#define ACCEL_2G_PRESC 16384
+/* Standard gravity, m/s^2 are the units of the converted accel channels */
+#define ACCEL_G_MS2    9.80665
 
-// #define ACCEL_MG(a) ( \
-// { \
-//     u64 _val = 0; \
-//     for (u8 i = 0; i < 3; i++) \
-//         _val += isqr((a + i) * ACCEL_MG_SCALE / ACCEL_2G_PRESC);  \
-//     isqrt(_val); \
-// })
+/* Scans of a batch, the three accel axes take at least 6 bytes */
+#define FF_SCAN_MAX    (IIOBUFF_READ_LEN / (3U * sizeof(s16)))
 
 
 /**********************************************************************************************************************
  * LOCAL TYPEDEFS DECLARATION
  *********************************************************************************************************************/
-typedef enum {
-    STATUS_FLIGHT,
-    STATUS_PREFALL,
-    STATUS_FALL,
-    STATUS_PREFLIGHT,
-} falling_status_t;
-
 typedef struct {
-    falling_status_t fs_stat;
+    ffdet_phase_t fs_stat;
     int fs_cnt;
     int fs_delta;
-    u32 fs_sample;
+    bool fs_low;
+    const double *fs_scan;
+    /* mg of a converted value of the device */
+    double fs_mg_unit;
+    u64 fs_ts;
 } flight_status_t;
 
 /**********************************************************************************************************************
  * GLOBAL VARIABLES DECLARATION
  *********************************************************************************************************************/
 
+/* Carried across frames, the detector continues with the first scan of the next batch */
 static flight_status_t flight_status = {
-    .fs_stat = STATUS_FLIGHT,
+    .fs_stat = FFDET_FLIGHT,
     .fs_cnt = 5,
     .fs_delta = 0,
 };
 
+static const char *phase_names[] = {"FLIGHT", "PREFALL", "FALL", "PREFLIGHT"};
+
+/* Axis columns of the batch for the magnitude kernel */
+static s16 col_x[FF_SCAN_MAX], col_y[FF_SCAN_MAX], col_z[FF_SCAN_MAX];
+static u64 low_mask[ACCMAG_MASK_WORDS(FF_SCAN_MAX)];
+
 /**********************************************************************************************************************
  * LOCAL FUNCTION DECLARATION
  *********************************************************************************************************************/
-u32 isqrt(u64 num);
+static u32 isqrt(u64 num);
 static void flight_handler(void);
 static void prefall_handler(void);
 static void fall_handler(void);
@@ -73,9 +77,9 @@ static void preflight_handler(void);
 /**********************************************************************************************************************
  * LOCAL FUNCTION DEFINITION
  *********************************************************************************************************************/
-u32 isqrt(u64 num) {
+static u32 isqrt(u64 num) {
     u32 res = 0, tmp = 0; // result
-    u32 add = 1 << 31;
+    u32 add = 1U << 31;
     u64 quad; // 'A^2'
 
     while ( add > 0 ) {
@@ -90,118 +94,169 @@ u32 isqrt(u64 num) {
     return res;
 }
 
-u32 get_accel_mg(const s64 *data) {
+static u32 get_accel_mg(const double *data, const double mg_unit) {
     u64 accel = 0;
     s64 tmp;
     for (u8 i = 0; i < 3; i++) {
-        tmp = ((data[i] * (1000L) / (16384L)));
+        tmp = llround(data[i] * mg_unit);
         accel += (1LU) * (tmp * tmp);
     }
 
     return isqrt(accel);
 }
 
+/* Converted values are in m/s^2, without a scale attribute they stay raw counts of the +-2 g range */
+static double get_mg_unit(const habdev_t *accel_dev) {
+    if (!accel_dev->conv.chan[0].scaled)
+        return (double)ACCEL_MG_SCALE / ACCMAG_1G_RAW;
+
+    return ACCEL_MG_SCALE / ACCEL_G_MS2;
+}
+
+/* Squared raw magnitude of the threshold for the kernel, from the scale of the device. Axes share the range. */
+static u32 get_thr_sq(const habdev_t *accel_dev) {
+    double thr = 0;
+
+    if (!accel_dev->conv.chan[0].scaled)
+        return ACCMAG_THR_SQ(FF_G_THR);
+
+    thr = FF_G_THR * ACCEL_G_MS2 / ACCEL_MG_SCALE / accel_dev->conv.chan[0].scale;
+
+    return (u32)fmin(thr * thr, (double)UINT32_MAX);
+}
+
+/* Every phase change goes out as an event, subscribers see the sample that caused it.
+ * The magnitude in mg is only computed here, the per sample test is done on squared raw values. */
+static void set_phase(const ffdet_phase_t phase) {
+    ev_msg_t msg = {0};
+
+    msg.topic = EV_TOPIC_FLIGHT_PHASE;
+    msg.ts_ns = flight_status.fs_ts;
+    msg.data.flight_phase.phase = phase;
+    msg.data.flight_phase.prev = flight_status.fs_stat;
+    msg.data.flight_phase.accel_mg = get_accel_mg(flight_status.fs_scan, flight_status.fs_mg_unit);
+
+    flight_status.fs_stat = phase;
+    event_publish(&msg);
+}
+
 static void flight_handler(void) {
-    if ((STATUS_FLIGHT == flight_status.fs_stat) && flight_status.fs_cnt < 0) {
-        flight_status.fs_stat = STATUS_PREFALL;
+    if ((FFDET_FLIGHT == flight_status.fs_stat) && flight_status.fs_cnt < 0) {
         flight_status.fs_delta = 0;
-        printf("PREFALL\n");
+        set_phase(FFDET_PREFALL);
     }
 }
 
 static void prefall_handler(void) {
-    if (STATUS_PREFALL == flight_status.fs_stat) {
+    if (FFDET_PREFALL == flight_status.fs_stat) {
         if (flight_status.fs_cnt > PREFALL_DEBOUNCE) {
-            flight_status.fs_stat = STATUS_FLIGHT;
-            printf("DELTA: %d\n", flight_status.fs_delta++);
+            set_phase(FFDET_FLIGHT);
         } else {
-            if (flight_status.fs_sample < FF_G_THR)
+            if (flight_status.fs_low)
                 flight_status.fs_delta++;
-            else if (flight_status.fs_sample > FF_G_THR && flight_status.fs_delta > 0)
+            else if (flight_status.fs_delta > 0)
                 flight_status.fs_delta--;
 
-            if (FF_G_FALL_WIN == flight_status.fs_delta) {
-                flight_status.fs_stat = STATUS_FALL;
-                printf("FALLING\n");
-            }
+            if (FF_G_FALL_WIN == flight_status.fs_delta)
+                set_phase(FFDET_FALL);
         }
     }
 }
 
 static void fall_handler(void) {
-    if (STATUS_FALL == flight_status.fs_stat) {
+    if (FFDET_FALL == flight_status.fs_stat) {
         if (flight_status.fs_cnt > 0) {
-            flight_status.fs_stat = STATUS_PREFLIGHT;
             flight_status.fs_delta = 0;
+            set_phase(FFDET_PREFLIGHT);
         }
     }
 }
 
 static void preflight_handler(void) {
-    if (STATUS_PREFLIGHT == flight_status.fs_stat) {
+    if (FFDET_PREFLIGHT == flight_status.fs_stat) {
         if (flight_status.fs_cnt < -1) {
-            flight_status.fs_stat = STATUS_FALL;
+            set_phase(FFDET_FALL);
         } else {
             flight_status.fs_delta++;
             if (FF_G_FLIGHT_WIN == flight_status.fs_delta)
-                flight_status.fs_stat = STATUS_FLIGHT;
+                set_phase(FFDET_FLIGHT);
         }
     }
 }
 
+static void process_sample(const bool low, const double *scan, const u64 ts) {
+    flight_status.fs_low = low;
+    flight_status.fs_scan = scan;
+    flight_status.fs_ts = ts;
+
+    if (low && (flight_status.fs_cnt > FF_G_LIMIT_LOWER))
+        flight_status.fs_cnt--;
+    else if (!low && (flight_status.fs_cnt < FF_G_LIMIT_UPPER))
+        flight_status.fs_cnt++;
+
+    switch (flight_status.fs_stat) {
+        case FFDET_FLIGHT:
+            flight_handler();
+            break;
+        case FFDET_PREFALL:
+            prefall_handler();
+            break;
+        case FFDET_FALL:
+            fall_handler();
+            break;
+        case FFDET_PREFLIGHT:
+            preflight_handler();
+            break;
+        default:
+            break;
+    }
+}
+
 /**********************************************************************************************************************
  * GLOBAL FUNCTION DEFINITION
  *********************************************************************************************************************/
+/* Drains the buffer of the IMU into its log and runs the detector over every scan of the batch.
+ * The first three channels of a scan are the accel axes, see the buffer configuration of the device. */
 void ffdet_process_frame(const habdev_t *accel_dev) {
-    u8 raw_data_buff[4096]  = {0};
-    s64 data_buff[2048] = {0};
-    char path_buff[128] = {0};
-    char data_available_buff[8] = {0};
-    int raw_data_samples = 0, accel_samples = 0;
-
-    /* REWRITE TO CORRECTLY EXTRACT BUFFER PATH */
-    // snprintf(path_buff, sizeof(path_buff), "%s/buffer/data_available", accel_dev->path.dev_path);
-    (void)read_file(path_buff, data_available_buff, sizeof(data_available_buff), MOD_R);
-    CROP_NEWLINE(data_available_buff, strlen(data_available_buff));
-
-    raw_data_samples = min(4092, atoi(data_available_buff) * 6);
-
-    /* REWRITE THE DEVICE DATA PATH */
-    // (void)read_file(accel_dev->path.dev_data[0], (char *)raw_data_buff, raw_data_samples, MOD_RW);
-    accel_samples = iiobuff_extract_data(accel_dev->df, data_buff, raw_data_buff, raw_data_samples);
-    printf("accel_smpl: %d\n", raw_data_samples);
-    // printf("----------FRAME-------------\n");
-
-    for (int i = 0; i < accel_samples; i += 3 ) {
-        flight_status.fs_sample = get_accel_mg(data_buff + i);
-        // printf("%u\n", flight_status.fs_sample);
-        // printf("%d %d %d\n", data_buff[i], data_buff[i + 1], data_buff[i + 2]);
-
-        if ((flight_status.fs_sample <= FF_G_THR) && (flight_status.fs_cnt > FF_G_LIMIT_LOWER))
-            flight_status.fs_cnt--;
-        else if ((flight_status.fs_sample > FF_G_THR) && (flight_status.fs_cnt < FF_G_LIMIT_UPPER))
-            flight_status.fs_cnt++;
-        
-        switch (flight_status.fs_stat) {
-            case STATUS_FLIGHT:
-                flight_handler();
-                break;
-            case STATUS_PREFALL:
-                prefall_handler();
-                break;
-            case STATUS_FALL:
-                fall_handler();
-                break;
-            case STATUS_PREFLIGHT:
-                preflight_handler();
-                break;
-            default:
-                break;
-        }
+    int raw_data_len = 0, accel_samples = 0;
+    u8 chan_num = accel_dev->df.chan_num;
+    usize scan_num = 0;
+    const s64 *scan = NULL;
+    const s64 *vals = NULL;
+    const double *si = NULL;
+    u64 ts = habtime_nowNs();
+
+    raw_data_len = iiobuff_log2file(accel_dev, NULL, NULL);
+    if (raw_data_len <= 0 || chan_num < 3)
+        return;
+
+    /* The raw columns feed the magnitude kernel, the converted ones the reported magnitude */
+    accel_samples = iiobuff_getBatch(&vals, &si);
+    scan_num = min((usize)(accel_samples / chan_num), (usize)FF_SCAN_MAX);
 
-        printf("status: %d, counter: %d, delta: %d, val: %d\n", flight_status.fs_stat, flight_status.fs_cnt, flight_status.fs_delta, flight_status.fs_sample);
+    for (usize i = 0; i < scan_num; i++) {
+        scan = vals + i * chan_num;
+        col_x[i] = (s16)scan[0];
+        col_y[i] = (s16)scan[1];
+        col_z[i] = (s16)scan[2];
     }
-    // printf("-----FRAME_END------\n");
+
+    (void)accmag_belowMask(col_x, col_y, col_z, scan_num, get_thr_sq(accel_dev), low_mask);
+    flight_status.fs_mg_unit = get_mg_unit(accel_dev);
+
+    for (usize i = 0; i < scan_num; i++) {
+        if (accel_dev->df.ts_en)
+            ts = (u64)vals[i * chan_num + chan_num - 1];
+        process_sample(0 != (low_mask[i / 64U] & (1ULL << (i % 64U))), si + i * chan_num, ts);
+    }
+}
+
+ffdet_phase_t ffdet_getPhase(void) {
+    return flight_status.fs_stat;
+}
+
+const char *ffdet_getPhaseName(const u8 phase) {
+    return (phase < ARRAY_SIZE(phase_names)) ? phase_names[phase] : "UNKNOWN";
 }
 
 /***********************************************************************************************************************
@@ -1,5 +1,6 @@
 #include <time.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <unistd.h>
@@ -8,7 +9,9 @@
 #include "utils.h"
 #include "task_main.h"
 #include "hab_device.h"
-#include "wheatstone.h"
+#include "storage_budget.h"
+#include "hab_time.h"
+#include "telemetry.h"
 
 #define TASK_MAIN_SUBPATH "/task_main"
 #define TASK_MAIN_LOGFILE "/dev_readout"
@@ -28,7 +31,7 @@ static stdret_t init_measurement(const ev_glob_t *ev_glob) {
     if (stat(path_buffer, &st) == -1)
         retval = (stdret_t)mkdir(path_buffer, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
 
-    snprintf(format_buffer, sizeof(format_buffer), "DATA FORMAT: VALUES FROM LEFT TO RIGHT.\nTIMESTAMP ALWAYS IS FIRST\n");
+    snprintf(format_buffer, sizeof(format_buffer), "DATA FORMAT: VALUES FROM LEFT TO RIGHT.\nTIMESTAMP ALWAYS IS FIRST, CLOCK_MONOTONIC NS\n");
     for (u8 i = 0; i < ev_glob->measured_dev_no; i++) {
         habdev = habdev_get(ev_glob->measured_dev[i]);
         for (u8 ch_num = 0; ch_num < habdev->channel_num; ch_num++) {
@@ -49,36 +52,53 @@ static stdret_t init_measurement(const ev_glob_t *ev_glob) {
 
 void task_runMain(const ev_glob_t *ev_glob) {
     habdev_t *habdev = NULL;
-    time_t ts;
     char dev_path[64] = {0};
     char log_buff[128] = {0};
     char path_buff[128] = {0};
     char readout_buff[16] = {0};
+    s64 chan_vals[TELEM_CHAN_MAX] = {0};
+    double chan_si[TELEM_CHAN_MAX] = {0};
+    u32 err_mask = 0;
+    bool present = false;
+    char *end = NULL;
+    u64 ts = 0;
 
     if (0 == log_format_set)
         init_measurement(ev_glob);
     
-    ts = time(NULL);
-    snprintf (log_buff, sizeof(log_buff), "%ld ", ts);
+    snprintf(log_buff, sizeof(log_buff), "%llu ", (unsigned long long)habtime_nowNs());
 
     for (u8 i = 0; i < ev_glob->measured_dev_no; i++) {
         habdev = habdev_get(ev_glob->measured_dev[i]);
-        if ((0 == str_compare(habdev->path.dev_name, "ads1115_48")) || (0 == str_compare(habdev->path.dev_name, "ads1115_49")))
-            wheatstone_runSingleChan(habdev);
-        habdev_getDevPath(habdev, dev_path, sizeof(dev_path));
+        present = (STD_OK == habdev_getDevPath(habdev, dev_path, sizeof(dev_path)));
+        err_mask = 0;
+        ts = habtime_nowNs();
 
         for (u8 ch_no = 0; ch_no < habdev->channel_num; ch_no++) {
+            /* A device off the bus is logged as failed reads */
+            memset(readout_buff, 0, sizeof(readout_buff));
             snprintf(path_buff, sizeof(path_buff), "%s%s", dev_path, habdev->path.channel[ch_no]);
-            (void)read_file(path_buff, readout_buff, sizeof(readout_buff), MOD_R);
-            CROP_NEWLINE(readout_buff, strlen(readout_buff));
+            if (present && STD_OK == read_file(path_buff, readout_buff, sizeof(readout_buff), MOD_R))
+                CROP_NEWLINE(readout_buff, strlen(readout_buff));
+
+            if (ch_no < TELEM_CHAN_MAX) {
+                /* A failed read leaves the buffer empty */
+                chan_vals[ch_no] = strtoll(readout_buff, &end, 10);
+                if (end == readout_buff)
+                    err_mask |= 1U << ch_no;
+                /* Processed attributes, e.g. in_temp_input, are already in the units of the IIO ABI */
+                chan_si[ch_no] = strtod(readout_buff, NULL);
+            }
 
             strcat(readout_buff, " ");
             strcat(log_buff, readout_buff);
             usleep(1000);
         }
+        telem_publish(habdev->index, chan_vals, chan_si, (u8)habdev->channel_num, ts, err_mask);
     }
     strcat(log_buff, "\n");
 
     snprintf(path_buff, sizeof(path_buff), "%s%s%s", HAB_DATASTORAGE_PATH, TASK_MAIN_SUBPATH, TASK_MAIN_LOGFILE);
-    (void)write_file(path_buff, log_buff, strlen(log_buff), MOD_A);
+    if (STD_OK == write_file(path_buff, log_buff, strlen(log_buff), MOD_A))
+        budget_account(BUDGET_SENSOR, strlen(log_buff));
 }
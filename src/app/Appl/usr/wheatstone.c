@@ -3,7 +3,9 @@
 ***********************************************************************************************************************
 * DESCRIPTION :                                                                                                       *
 *       Application specific code called from callback. Contains and API for processing ADC readouts                  *
-*       in pair with controlling the digital potentiometers attached to them.                                         *
+*       in pair with controlling the digital potentiometers attached to them. Every drained batch of the ADC          *
+*       buffer is one step of a PI controller per bridge, the digipot is moved rate limited. At startup and on        *
+*       a saturated ADC the wiper is bisected against the sign of the bridge output first, ~10 batches.               *
 *                                                                                                                     *
 * PUBLIC FUNCTIONS :                                                                                                  *
 *       void                wheatstone_run(const habdev_t *adc_dev)                                                   *
@@ -12,7 +14,7 @@
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
 *                                                                                                                     *
 * VERSION                                                                                                             *
-*       0.0.1               last modification: 23-04-2024                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
 *                                                                                                                     *
 * LICENSE                                                                                                             *
 *       GPL                                                                                                           *
@@ -22,13 +24,16 @@
 /**********************************************************************************************************************
  *  INCLUDES
  *********************************************************************************************************************/
+#include <math.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "utils.h"
 #include "wheatstone.h"
 #include "hab_device.h"
 #include "iio_buffer_ops.h"
+#include "hab_time.h"
 
 #if (defined IIO_KMOD_IDX_ADS1115_48) && (defined IIO_KMOD_IDX_ADS1115_48)
 
@@ -36,17 +41,26 @@
  *  PREPROCESSOR DEFINITIONS
  *********************************************************************************************************************/
 #define POT_RESOLUTION   10u
-#define DEB_THRESHOLD    1
 
-#define WIPER_STEP       1
-#define WIPER_MAX_POS    (0x01 << POT_RESOLUTION)
+#define WIPER_MAX_POS    ((0x01 << POT_RESOLUTION) - 1)
 #define WIPER_MIN_POS    0
 
-#define VOLTAGE_THR_LOW  -1000
-#define VOLTAGE_THR_HIGH 1000
-
-#define UINT16_MAX_VAL 32767U
-#define UINT16_PRESC   65536
+/* Bridge output the controller drives to, ADC counts */
+#define WHTST_SETPOINT   0.0f
+/* Wiper steps per ADC count and per ADC count and second. A higher wiper raises the bridge output. */
+#define WHTST_KP         0.001f
+#define WHTST_KI         0.004f
+/* Errors below that are noise, the integrator holds */
+#define WHTST_DEADBAND   100.0f
+/* Wiper steps per second, the digipot is never moved faster */
+#define WHTST_SLEW_STEPS 64.0f
+/* Longest gap between two updates taken into the integrator */
+#define WHTST_DT_MAX_S   5.0f
+/* Bridge output taken as a saturated ADC and the updates it has to last before the wiper is bisected again */
+#define WHTST_SAT_COUNTS  32000.0f
+#define WHTST_SAT_UPDATES 3U
+/* Conversions started this soon after a wiper move may still see the old position */
+#define WHTST_SETTLE_NS   20000000ULL
 
 /**********************************************************************************************************************
  * LOCAL TYPEDEFS DECLARATION
@@ -57,23 +71,31 @@ typedef struct {
     int digipot_dev[8];
 } whtst_setup_t;
 
+typedef enum {
+    WHTST_BALANCE,
+    WHTST_TRACK,
+} whtst_mode_t;
+
 typedef struct {
+    whtst_mode_t mode;
     int wiper;
-    int db_count;
+    int base;
+    float integ;
+    int lo;
+    int hi;
+    u8 sat_cnt;
+    u64 move_ns;
+    char path[128];
     habdev_t *digipot;
 } whtst_chan_t;
 
 typedef struct {
     int adc_id;
     u8 chan_num;
+    u64 last_ns;
     whtst_chan_t chan[8];
 } whtst_node_t;
 
-typedef enum {
-    WIPER_OP_INC,
-    WIPER_OP_DECR,
-} wiper_op_t;
-
 /* Below array shall be code generated (in ideal world) */
 whtst_setup_t setup[] = {
     {
@@ -104,7 +126,11 @@ static int wht_node_cnt;
  *********************************************************************************************************************/
 static whtst_node_t *get_wht_node(const int adc_index);
 static whtst_node_t *wheatstone_init(const int adc_index);
-static void wiper_change(whtst_chan_t *chan, wiper_op_t wiper_op);
+static void wiper_set(whtst_chan_t *chan, int wiper);
+static int pi_update(whtst_chan_t *chan, float err, float dt);
+static void balance_start(whtst_chan_t *chan);
+static void balance_update(whtst_chan_t *chan, float err);
+static bool is_saturated(whtst_chan_t *chan, float err);
 
 
 /**********************************************************************************************************************
@@ -122,15 +148,25 @@ static whtst_node_t *get_wht_node(const int adc_index) {
     return node;
 }
 
+/* Wiper attribute of the digipot, resolved again after a failed write as the device may have moved on the bus */
+static bool wiper_path(whtst_chan_t *chan) {
+    if (0 != chan->path[0])
+        return true;
+    if (NULL == chan->digipot || STD_NOT_OK == habdev_getDevPath(chan->digipot, chan->path, sizeof(chan->path)))
+        return false;
+
+    strncat(chan->path, chan->digipot->path.channel[0], sizeof(chan->path) - strlen(chan->path) - 1);
+    return true;
+}
+
 static whtst_node_t *wheatstone_init(const int adc_index) {
     whtst_node_t *node = NULL;
-    habdev_t *digipot_dev = NULL;
+    whtst_chan_t *chan = NULL;
     char wiper_buff[8];
-    char dev_path[128] = {0};
 
     node = (whtst_node_t *) malloc(sizeof(whtst_node_t));
-    memset(node, 0, sizeof(whtst_node_t));
     if (NULL != node) {
+        memset(node, 0, sizeof(whtst_node_t));
         wht_nodes[wht_node_cnt++] = node;
     } else {
         fprintf(stderr, "ERROR: Error allocation wheatstone device.\n");
@@ -142,16 +178,16 @@ static whtst_node_t *wheatstone_init(const int adc_index) {
         if (setup[i].adc_dev == node->adc_id) {
             node->chan_num = setup[i].chan_num;
             for (int dgpt = 0; dgpt < node->chan_num; dgpt++) {
-                digipot_dev = habdev_get(setup[i].digipot_dev[dgpt]);
-                node->chan[dgpt].digipot = digipot_dev;
+                chan = &node->chan[dgpt];
+                chan->digipot = habdev_get(setup[i].digipot_dev[dgpt]);
 
-                habdev_getDevPath(digipot_dev, dev_path, sizeof(dev_path));
-                strcat(dev_path, digipot_dev->path.channel[0]);
 
-                /* Read initial wiper position */
-                (void)read_file(dev_path, wiper_buff, sizeof(wiper_buff), MOD_R);
-                CROP_NEWLINE(wiper_buff, strlen(wiper_buff));
-                node->chan[dgpt].wiper = atoi(wiper_buff);
+                /* The controller starts from the configured wiper position */
+                memset(wiper_buff, 0, sizeof(wiper_buff));
+                if (wiper_path(chan) && STD_OK == read_file(chan->path, wiper_buff, sizeof(wiper_buff), MOD_R))
+                    CROP_NEWLINE(wiper_buff, strlen(wiper_buff));
+                chan->wiper = atoi(wiper_buff);
+                balance_start(chan);
             }
         }
     }
@@ -159,24 +195,86 @@ static whtst_node_t *wheatstone_init(const int adc_index) {
     return  node;
 }
 
-static void wiper_change(whtst_chan_t *chan, wiper_op_t wiper_op) {
+/* The digipot is written only when the wiper actually moves */
+static void wiper_set(whtst_chan_t *chan, int wiper) {
     char wiper_buff[8] = {0};
-    char dev_path[128] = {0};
-    habdev_t *habdev = chan->digipot;
 
-    habdev_getDevPath(habdev, dev_path, sizeof(dev_path));
-    strcat(dev_path, habdev->path.channel[0]);
+    if (wiper == chan->wiper || !wiper_path(chan))
+        return;
 
-    if (WIPER_OP_INC == wiper_op) {
-        if (chan->wiper + WIPER_STEP < WIPER_MAX_POS)
-            chan->wiper += WIPER_STEP;
+    snprintf(wiper_buff, sizeof(wiper_buff), "%d", wiper);
+    if (STD_OK == write_file(chan->path, wiper_buff, strlen(wiper_buff), MOD_W)) {
+        chan->wiper = wiper;
+        chan->move_ns = habtime_nowNs();
     } else {
-        if (chan->wiper - WIPER_STEP >= WIPER_MIN_POS)
-            chan->wiper -= WIPER_STEP;
+        chan->path[0] = 0;
     }
-    
-    snprintf(wiper_buff, sizeof(wiper_buff), "%d", chan->wiper);
-    write_file(dev_path, wiper_buff, sizeof(wiper_buff), MOD_W);
+}
+
+/*
+ * Positional PI around the starting wiper. When the wiper travel or the slew limit cuts the output, the
+ * integrator is set back to what was actually applied, so it never winds up past the digipot.
+ */
+static int pi_update(whtst_chan_t *chan, float err, float dt) {
+    float p = WHTST_KP * err;
+    float step_max = fmaxf(WHTST_SLEW_STEPS * dt, 1.0f);
+    float out = 0;
+
+    if (fabsf(err) > WHTST_DEADBAND)
+        chan->integ += WHTST_KI * err * dt;
+
+    out = fminf(fmaxf(chan->base + p + chan->integ, (float)WIPER_MIN_POS), (float)WIPER_MAX_POS);
+    out = fminf(fmaxf(out, chan->wiper - step_max), chan->wiper + step_max);
+    chan->integ = out - chan->base - p;
+
+    return (int)lroundf(out);
+}
+
+static void balance_start(whtst_chan_t *chan) {
+    chan->mode = WHTST_BALANCE;
+    chan->lo = WIPER_MIN_POS;
+    chan->hi = WIPER_MAX_POS;
+    chan->sat_cnt = 0;
+    wiper_set(chan, (chan->lo + chan->hi) / 2);
+}
+
+/* One bisection step per batch converted after the last move, the wiper range halves every time */
+static void balance_update(whtst_chan_t *chan, float err) {
+    int probe = (chan->lo + chan->hi) / 2;
+
+    /* A probe the digipot did not take says nothing about the range, it is written again and the range kept */
+    if (chan->wiper != probe) {
+        wiper_set(chan, probe);
+        return;
+    }
+
+    if (err > 0)
+        chan->lo = chan->wiper;
+    else
+        chan->hi = chan->wiper;
+
+    if (chan->hi - chan->lo > 1) {
+        wiper_set(chan, (chan->lo + chan->hi) / 2);
+        return;
+    }
+
+    /* The last probe is within a step of the balance, the PI tracks from there */
+    chan->mode = WHTST_TRACK;
+    chan->base = chan->wiper;
+    chan->integ = 0;
+    printf("INFO: Bridge of %s balanced at wiper %d.\n", chan->digipot->path.dev_name, chan->wiper);
+}
+
+/* A wiper pinned at the end of its travel would bisect to the same end, the bridge is out of range then */
+static bool is_saturated(whtst_chan_t *chan, float err) {
+    bool pinned = (chan->wiper >= WIPER_MAX_POS && err > 0) || (chan->wiper <= WIPER_MIN_POS && err < 0);
+
+    if (fabsf(err) < WHTST_SAT_COUNTS || pinned) {
+        chan->sat_cnt = 0;
+        return false;
+    }
+
+    return ++chan->sat_cnt >= WHTST_SAT_UPDATES;
 }
 
 /**********************************************************************************************************************
@@ -184,81 +282,59 @@ static void wiper_change(whtst_chan_t *chan, wiper_op_t wiper_op) {
  *********************************************************************************************************************/
 void wheatstone_run(const habdev_t *adc_dev) {
     whtst_node_t *node = get_wht_node(adc_dev->index);
-    
-    int size, channel = 0;
-    u8   data_raw[4096]     = {0};
-    s64  data_frame[1024]   = {0};
+    u8 scan_len = adc_dev->df.chan_num;
+    int size, val_num, scan_num = 0;
+    const s64 *data_frame = NULL;
     char wiper_pos_buff[16] = {0};
+    float err[8] = {0};
+    int err_num[8] = {0};
+    whtst_chan_t *chan = NULL;
+    float dt = 0;
+    u64 now = 0;
 
     if (NULL == node)
         node = wheatstone_init(adc_dev->index);
+    if (NULL == node)
+        return;
 
     for (int i = 0; i < node->chan_num; i++)
-        snprintf(wiper_pos_buff + strlen(wiper_pos_buff), sizeof(wiper_pos_buff), 
+        snprintf(wiper_pos_buff + strlen(wiper_pos_buff), sizeof(wiper_pos_buff) - strlen(wiper_pos_buff),
             "%d%c", node->chan[i].wiper, (i == node->chan_num - 1) ? '\0' : ' ');
     
-    size = iiobuff_log2file(adc_dev, wiper_pos_buff, data_raw);
-    size = iiobuff_extract_data(adc_dev->df, data_frame, data_raw, size);
-    
-    // for (int i = 0; i < node->chan_num; i++)
-    //     node->chan[i].db_count = 0;
-
-    // for (int i = 0; i < size; i++) {
-    //     channel = i % node->chan_num;
-    //     if (data_frame[i] > VOLTAGE_THR_HIGH) {
-    //         node->chan[channel].db_count++;
-    //     } else if (data_frame[i] < VOLTAGE_THR_LOW) {
-    //         node->chan[channel].db_count--;
-    //     } else {
-    //         if (node->chan[channel].db_count != 0)
-    //             node->chan[channel].db_count > 0 ? node->chan[channel].db_count-- : node->chan[channel].db_count++;
-    //     }
-    // }
-
-    // for (int i = 0; i < node->chan_num; i++) {
-    //     if (node->chan[i].db_count > DEB_THRESHOLD)
-    //         wiper_change(&node->chan[i], WIPER_OP_DECR);
-    //     else if (node->chan[i].db_count < -DEB_THRESHOLD)
-    //         wiper_change(&node->chan[i], WIPER_OP_INC);
-    // }
-}
-
-void wheatstone_runSingleChan(const habdev_t *adc_dev) {
-    whtst_node_t *node = get_wht_node(adc_dev->index);
-
-    int chan_val = 0;
-    char dev_path[128] = {0};
-    char data_buffer[16] = {0};
-
-    if (NULL == node)
-        node = wheatstone_init(adc_dev->index);
-
-    for (int i = 0; i < node->chan_num; i++) {
-        habdev_getDevPath(adc_dev, dev_path, sizeof(dev_path));
-        strcat(dev_path, adc_dev->path.channel[i]);
-
-        (void)read_file(dev_path, data_buffer, sizeof(data_buffer), MOD_R);
-        CROP_NEWLINE(data_buffer, strlen(data_buffer));
-        chan_val = atoi(data_buffer);
-
-        if (chan_val > UINT16_MAX_VAL)
-            chan_val -= UINT16_PRESC;
-        
-        if (chan_val > VOLTAGE_THR_HIGH) {
-            if (node->chan[i].db_count < 5)
-                node->chan[i].db_count++;
-        } else if (chan_val < VOLTAGE_THR_LOW) {
-            if (node->chan[i].db_count > -5)
-                node->chan[i].db_count--;
-        } else {
-            if (node->chan[i].db_count != 0)
-                node->chan[i].db_count > 0 ? node->chan[i].db_count-- : node->chan[i].db_count++;
+    size = iiobuff_log2file(adc_dev, wiper_pos_buff, NULL);
+    if (size <= 0 || scan_len < node->chan_num)
+        return;
+
+    /* The bridge error of the batch is the mean of the scans converted after the last move, the ADC words are signed.
+     * The controller works on the raw columns, the saturation is a property of the ADC counts. */
+    val_num = iiobuff_getBatch(&data_frame, NULL);
+    for (int i = 0; i + scan_len <= val_num; i += scan_len, scan_num++) {
+        now = adc_dev->df.ts_en ? (u64)data_frame[i + scan_len - 1] : habtime_nowNs();
+        for (int ch = 0; ch < node->chan_num; ch++) {
+            if (adc_dev->df.ts_en && now < node->chan[ch].move_ns + WHTST_SETTLE_NS)
+                continue;
+            err[ch] += WHTST_SETPOINT - (float)(s16)data_frame[i + ch];
+            err_num[ch]++;
         }
-
-        if (node->chan[i].db_count > 2)
-            wiper_change(&node->chan[i], WIPER_OP_DECR);
-        else if (node->chan[i].db_count < -2)
-            wiper_change(&node->chan[i], WIPER_OP_INC);
+    }
+    if (0 == scan_num)
+        return;
+
+    if (0 != node->last_ns && now > node->last_ns)
+        dt = fminf((float)(now - node->last_ns) / 1e9f, WHTST_DT_MAX_S);
+    node->last_ns = now;
+
+    for (int ch = 0; ch < node->chan_num; ch++) {
+        chan = &node->chan[ch];
+        if (0 == err_num[ch])
+            continue;
+
+        if (WHTST_BALANCE == chan->mode)
+            balance_update(chan, err[ch] / err_num[ch]);
+        else if (is_saturated(chan, err[ch] / err_num[ch]))
+            balance_start(chan);
+        else
+            wiper_set(chan, pi_update(chan, err[ch] / err_num[ch], dt));
     }
 }
 
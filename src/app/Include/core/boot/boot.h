@@ -0,0 +1,62 @@
+/**********************************************************************************************************************
+* boot.h                                                                                                              *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the fast-boot orchestration. Kernel modules and dtoverlays are loaded by hab_master           *
+*       itself and every expected IIO device is reported as soon as the kernel announces it.                          *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct boot_ops_t   Hooks called by the boot sequence                                                         *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       void                boot_start(uv_loop_t *loop, const boot_ops_t *ops);                                       *
+*       void                boot_expectDev(const u32 dev_idx);                                                        *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <uv.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define BOOT_TIMEOUT_MS 30000U
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    /* IIO core and trigger modules are available, expected devices shall be announced from here */
+    void (*core_ready)(void);
+    /* Expected device appeared on the IIO bus */
+    void (*dev_ready)(const u32 dev_idx);
+    /* All expected devices appeared or the boot timeout elapsed */
+    void (*done)(const usize missing);
+} boot_ops_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+void boot_start(uv_loop_t *loop, const boot_ops_t *ops);
+void boot_expectDev(const u32 dev_idx);
+
+#endif /* __BOOT_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
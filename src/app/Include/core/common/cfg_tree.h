@@ -18,6 +18,12 @@
 #define DEV_CONFIG_REG_CAM_ST   0x07 << 4
 #define DEV_CONFIG_REG_CAM_VID  0x08 << 4
 #define DEV_CONFIG_REG_EV_G_REF 0x09 << 4
+#define DEV_CONFIG_REG_WINDOW   0x0A << 4
+#define DEV_CONFIG_REG_HOP      0x0B << 4
+#define DEV_CONFIG_REG_RAW      0x0C << 4
+#define DEV_CONFIG_REG_PRE      0x0D << 4
+#define DEV_CONFIG_REG_POST     0x0E << 4
+#define DEV_CONFIG_REG_SLOPE    0x0F << 4
 #define DEV_CONFIG_REG_BUFF     0x01 << 12
 #define DEV_CONFIG_REG_CHAN     0x02 << 12
 #define DEV_CONFIG_REG_BUFF_CH  0x03 << 12
@@ -25,6 +31,8 @@
 #define DEV_CONFIG_REG_CAM      0x05 << 12
 #define DEV_CONFIG_REG_PARAM    0x06 << 12
 #define DEV_CONFIG_REG_INDEX    0x07 << 12
+#define DEV_CONFIG_REG_STATS    0x08 << 12
+#define DEV_CONFIG_REG_CAPTURE  0x09 << 12
 
 #define DEV_CONFIG_REG_DEVTYPE_DEFAULT 0x00
 #define DEV_CONFIG_REG_DEVTYPE_IIO     0x01 << 16
@@ -46,6 +54,12 @@
 #define CFGTREE_CAM_STILL_CONFIG        ((DEV_CONFIG_REG_CAM) | (DEV_CONFIG_REG_CAM_ST) | (DEV_CONFIG_REG_VAL))
 #define CFGTREE_CAM_VIDEO_CONFIG        ((DEV_CONFIG_REG_CAM) | (DEV_CONFIG_REG_CAM_VID) | (DEV_CONFIG_REG_VAL))
 #define CFGTREE_INDEX                   ((DEV_CONFIG_REG_INDEX) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_STATS_WINDOW_CONFIG     ((DEV_CONFIG_REG_STATS) | (DEV_CONFIG_REG_WINDOW) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_STATS_HOP_CONFIG        ((DEV_CONFIG_REG_STATS) | (DEV_CONFIG_REG_HOP) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_STATS_RAW_CONFIG        ((DEV_CONFIG_REG_STATS) | (DEV_CONFIG_REG_RAW) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_CAPTURE_PRE_CONFIG      ((DEV_CONFIG_REG_CAPTURE) | (DEV_CONFIG_REG_PRE) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_CAPTURE_POST_CONFIG     ((DEV_CONFIG_REG_CAPTURE) | (DEV_CONFIG_REG_POST) | (DEV_CONFIG_REG_VAL))
+#define CFGTREE_CAPTURE_SLOPE_CONFIG    ((DEV_CONFIG_REG_CAPTURE) | (DEV_CONFIG_REG_SLOPE) | (DEV_CONFIG_REG_VAL))
 
 typedef enum {
     ST_DEFAULT,
@@ -79,6 +93,14 @@ typedef enum {
     CFG_FIELD_VAL,
     CFG_BUFF_LEN_T,
     CFG_BUFF_ENABLE,
+    CFG_STATS,
+    CFG_STATS_WINDOW,
+    CFG_STATS_HOP,
+    CFG_STATS_RAW,
+    CFG_CAPTURE,
+    CFG_CAPTURE_PRE,
+    CFG_CAPTURE_POST,
+    CFG_CAPTURE_SLOPE,
     CFG_TYPE_NUM,
 } cfg_type_tree_t;
 
@@ -100,6 +122,7 @@ typedef struct
 
 
 node_t *cfgtree_init(xml_line_t **line);
+node_t *cfgtree_load(const char *path);
 void cfgtree_free(node_t *root);
 
 void cfgtree_initDfa(void);
@@ -0,0 +1,9 @@
+#ifndef __CRC32C_H__
+#define __CRC32C_H__
+
+#include "stdtypes.h"
+
+/* CRC32C (Castagnoli). Pass 0 as crc for the first chunk, the previous result to continue. */
+u32 crc32c(u32 crc, const void *buff, usize size);
+
+#endif /* __CRC32C_H__ */
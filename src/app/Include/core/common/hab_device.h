@@ -10,11 +10,15 @@
 
 habdev_t *habdev_alloc(void);
 habdev_t *habdev_get(const u32 idx);
+habdev_t *habdev_getByName(const char *name);
+dev_type_t habdev_getCfgType(const u32 idx);
 
 stdret_t habdev_register(habdev_t *dev, u32 idx);
+stdret_t habdev_reload(habdev_t *dev);
 
 void habdev_getLogPath(const habdev_t *habdev, char *buff, usize size);
-void habdev_getDevPath(const habdev_t *habdev, char *buff, usize size);
+/* Sysfs directory of the device with a trailing slash, STD_NOT_OK while the device is not on the bus */
+stdret_t habdev_getDevPath(const habdev_t *habdev, char *buff, usize size);
 
 void habdev_preinit(void);
 void habdev_postinit(void);
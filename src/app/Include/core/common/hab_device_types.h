@@ -7,8 +7,6 @@
 * PUBLIC TYPEDEFS :                                                                                                   *
 *       enum dev_type_t     Type of registered device. Used to handle R/W operation for a device                      *
 *       struct hab_path_t   Set of fs paths that are commonly used when controllin I/O device                         *
-*       struct data_format_t                                                                                          *
-*                           Defines a format how data is represented (for instance in a buffer)                       *
 *       struct hab_path_t   Set of fs paths that are commonly used when controllin I/O device                         *
 *       struct habdev_t     Set of data related to connected device. Main platform structure                          *
 *                                                                                                                     *
@@ -35,6 +33,10 @@
 #include "hab_trig.h"
 #include "cfg_tree.h"
 #include "event_types.h"
+#include "iio_scan.h"
+#include "iio_stats.h"
+#include "iio_capture.h"
+#include "iio_conv.h"
 
 /**********************************************************************************************************************
  *  PREPROCESSOR DEFINITIONS
@@ -60,12 +62,6 @@ typedef struct {
     char *buffer[4];
 } hab_path_t;
 
-typedef struct {
-    u8 chan_num;
-    u8 storagebits[16];
-    bool ts_en;
-} data_format_t;
-
 typedef struct {
     u8 id;
     u8 index;
@@ -73,10 +69,13 @@ typedef struct {
     hab_path_t path;
     habtrig_t *trig;
     data_format_t df;
+    iioconv_t conv;
     u32 channel_num;
     u32 buffer_num;
     node_t *node;
     dev_type_t dev_type;
+    iiostats_cfg_t stats;
+    iiocap_cfg_t capture;
 } habdev_t;
 
 /**********************************************************************************************************************
@@ -54,6 +54,7 @@ int get_word(const char *str, usize *pos, char *word, usize size);
 int get_line(const char *filepath, usize *foffset, char *buff, usize size);
 
 stdret_t hexdump(const char *filepath, const char *buff, usize size, const char *append);
+usize hexdump_str(char *dst, usize size, const char *buff, usize rec_num, const char *append);
 stdret_t read_file(const char *filepath, char *buff, usize size, file_mode_t fmod);
 stdret_t write_file(const char *filepath, const char *buff, usize size, file_mode_t fmod);
 
@@ -14,6 +14,7 @@
 *       CALLBACK            MLX90614_CALLBACK(uv_timer_t *handle);                                                    *
 *       CALLBACK            ICM20948_CALLBACK(uv_timer_t *handle);                                                      *
 *       CALLBACK            SHT4X_CALLBACK(uv_timer_t *handle);                                                       *
+*       CALLBACK            cfg_reload_callback(uv_fs_event_t *handle, ...);                                          *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -86,6 +87,8 @@ CALLBACK IMX477_02_CALLBACK(uv_timer_t *handle);
 CALLBACK EV_MAIN_CALLBACK(uv_timer_t *handle);
 #endif
 
+CALLBACK cfg_reload_callback(uv_fs_event_t *handle, const char *filename, int events, int status);
+
 #endif /* __CALLBACK_H__ */
 
 /***********************************************************************************************************************
@@ -3,8 +3,12 @@
 
 #include "event_types.h"
 
+#define EV_SUB_MAX  8
+
 void event_init(void);
 ev_t *event_alloc(void);
+stdret_t event_registerFsEv(ev_t *ev, const char *path,
+                            void (*fs_cb)(uv_fs_event_t *handle, const char *filename, int events, int status));
 ev_glob_t *event_allocGlobalEv(void);
 stdret_t event_registerGlobalEv(ev_glob_t *ev_glob, const u8 index);
 
@@ -17,4 +21,7 @@ ev_glob_t *event_getGlobalEv(const int id);
 
 stdret_t event_addMeasuredDev(const int ev_glob_id, const int habdev_id);
 
+stdret_t event_subscribe(const ev_topic_t topic, ev_sub_cb_t cb, void *ctx);
+void event_publish(const ev_msg_t *msg);
+
 #endif /* __EVENT_H__ */
\ No newline at end of file
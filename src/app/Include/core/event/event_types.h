@@ -22,6 +22,42 @@ typedef struct {
     void (*fs_cb)(uv_fs_event_t *handle, const char *filename, int events, int status);
 } ev_t;
 
+/* Topics of the in-process events, published and dispatched on the uv loop thread */
+typedef enum {
+    EV_TOPIC_FLIGHT_PHASE,
+    EV_TOPIC_SCAN,
+    EV_TOPIC_ALTITUDE,
+    EV_TOPIC_NUM,
+} ev_topic_t;
+
+typedef struct {
+    ev_topic_t topic;
+    u64 ts_ns;
+    union {
+        struct flight_phase {
+            u8 phase;
+            u8 prev;
+            u32 accel_mg;
+        } flight_phase;
+        /* A decoded read batch with the raw and the converted values, only valid during the dispatch */
+        struct scan {
+            u32 dev_idx;
+            u32 val_num;
+            u8 chan_num;
+            bool ts_en;
+            const s64 *vals;
+            const double *si;
+        } scan;
+        struct altitude {
+            s32 alt_mm;
+            s32 climb_mms;
+            s32 baro_mm;
+        } altitude;
+    } data;
+} ev_msg_t;
+
+typedef void (*ev_sub_cb_t)(const ev_msg_t *msg, void *ctx);
+
 typedef struct ev_glob {
     u8 id;
     u8 index;
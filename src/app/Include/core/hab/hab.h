@@ -3,5 +3,6 @@
 
 void hab_init(void);
 int hab_run(void);
+int hab_boot(void);
 
 #endif /* __HAB_H__ */
\ No newline at end of file
@@ -0,0 +1,39 @@
+/**********************************************************************************************************************
+* hab_clock.h                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the monotonic clock of the timestamp service. It carries no libuv dependency, so the          *
+*       post-flight tools that share the storage sources link it alone.                                               *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       u64                 habtime_nowNs(void);                                                                      *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __HAB_CLOCK_H__
+#define __HAB_CLOCK_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+u64 habtime_nowNs(void);
+
+#endif /* __HAB_CLOCK_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
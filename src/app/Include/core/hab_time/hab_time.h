@@ -0,0 +1,55 @@
+/**********************************************************************************************************************
+* hab_time.h                                                                                                          *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the timestamp service. Every record, media file and IIO kernel timestamp is stamped           *
+*       with CLOCK_MONOTONIC nanoseconds. The wall clock is only recorded in anchors, pairs of monotonic and          *
+*       realtime samples appended to HABTIME_ANCHOR_FILE, so a jump of the wall clock does not tear the logs          *
+*       and any monotonic stamp can be mapped to UTC after the flight. The clock itself is in hab_clock.h.            *
+*                                                                                                                     *
+*       Anchor line:                                                                                                  *
+*           <monotonic ns> <realtime ns> <uncertainty ns>                                                             *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            habtime_start(uv_loop_t *loop);                                                           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __HAB_TIME_H__
+#define __HAB_TIME_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <uv.h>
+#include "stdtypes.h"
+#include "hab_clock.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define HABTIME_ANCHOR_FILE     "/time_anchors"
+/* Anchors are written at this period and whenever the wall clock steps by more than HABTIME_STEP_NS */
+#define HABTIME_ANCHOR_MS       60000U
+#define HABTIME_CHECK_MS        1000U
+#define HABTIME_STEP_NS         1000000LL
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+stdret_t habtime_start(uv_loop_t *loop);
+
+#endif /* __HAB_TIME_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
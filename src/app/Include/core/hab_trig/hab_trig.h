@@ -11,12 +11,13 @@
 *       habtrig_t *         habtrig_alloc(void);                                                                      *
 *       void                habtrig_free(habtrig_t *trig);                                                            *
 *       stdret_t            habtrig_register(habtrig_t *trig, u32 period_ms);                                         *
+*       s32                 habtrig_lookup(const char *name);                                                         *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
 *                                                                                                                     *
 * VERSION                                                                                                             *
-*       0.0.1               last modification: 13-04-2024                                                             *
+*       0.0.2               last modification: 19-10-2026                                                             *
 *                                                                                                                     *
 * LICENSE                                                                                                             *
 *       GPL                                                                                                           *
@@ -58,5 +59,6 @@ habtrig_t *habtrig_alloc(void);
 habtrig_t *habtrig_get(const int index);
 void habtrig_free(habtrig_t *trig);
 stdret_t habtrig_register(habtrig_t *trig, u32 period_ms);
+s32 habtrig_lookup(const char *name);
 
 #endif /* __HAB_TRIG_H__ */
\ No newline at end of file
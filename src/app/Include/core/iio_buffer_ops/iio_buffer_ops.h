@@ -9,6 +9,7 @@
 *                                                                                                                     *
 * PUBLIC FUNCTIONS :                                                                                                  *
 *       stdret_t            iiobuff_log2file(char *ubuff, const habdev_t *habdev);                                    *
+*       int                 iiobuff_getBatch(const s64 **vals, const double **si);                                    *
 *                                                                                                                     *
 * AUTHOR :                                                                                                            *
 *       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
@@ -37,6 +38,8 @@
 /**********************************************************************************************************************
  *  PREPROCESSOR DEFINITIONS
  *********************************************************************************************************************/
+/* Largest batch read from a buffer, the size of the data_cpy of iiobuff_log2file */
+#define IIOBUFF_READ_LEN     4096U
 
 /**********************************************************************************************************************
  *  TYPEDEF ENUM DECLARATION
@@ -50,7 +53,10 @@
  * GLOBAL FUNCTION DECLARATION
  *********************************************************************************************************************/
 int iiobuff_log2file(const habdev_t *habdev, const char *append, u8 *data_cpy);
-int iiobuff_extract_data(data_format_t format, s64 *dst, const u8 *src, const usize size);
+int iiobuff_extract_data(const data_format_t *format, s64 *dst, const u8 *src, const usize size);
+void iiobuff_capture(const char *reason);
+/* Raw and converted values of the last read, whole scans only. Valid until the next read of any device. */
+int iiobuff_getBatch(const s64 **vals, const double **si);
 
 #endif /* __IIO_BUFFER_OPS_H__ */
 
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+* iio_capture.h                                                                                                       *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the pre-trigger ring of raw buffer records. The ring keeps the records of the last pre        *
+*       milliseconds in RAM. A trigger hands them out oldest first and forwards every record of the next post         *
+*       milliseconds, so a capture covers the moment from both sides at the full rate of the device.                  *
+*                                                                                                                     *
+*       Device configuration:                                                                                         *
+*           <capture>                                                                                                 *
+*               <pre>                                                                                                 *
+*                   <val>ms</val>                                                                                     *
+*               </pre>                                                                                                *
+*               <post>                                                                                                *
+*                   <val>ms</val>                                                                                     *
+*               </post>                                                                                               *
+*               <slope>                             - optional, raw counts per second of the first channel            *
+*                   <val>counts</val>                 a positive value triggers on a rise, a negative on a fall       *
+*               </slope>                                                                                              *
+*           </capture>                                                                                                *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct iiocap_cfg_t Capture configuration of a device, a zero post time disables the stage                    *
+*       struct iiocap_t     Capture state of a device                                                                 *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       iiocap_t *          iiocap_alloc(const iiocap_cfg_t *cfg);                                                    *
+*       usize               iiocap_push(iiocap_t *cap, const u8 *rec, usize rec_num, u64 first_ns, u64 last_ns);      *
+*       bool                iiocap_trigger(iiocap_t *cap, u64 now);                                                   *
+*       usize               iiocap_drain(iiocap_t *cap, u8 *out, usize rec_max);                                      *
+*       bool                iiocap_checkSlope(iiocap_t *cap, s64 val, u64 ts);                                        *
+*       void                iiocap_free(iiocap_t *cap);                                                               *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __IIO_CAPTURE_H__
+#define __IIO_CAPTURE_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+/* Ring depth in records, a longer pre time is cut to the newest records */
+#define IIOCAP_RING_REC     8192U
+/* Shortest span the slope is taken over, so a single noisy scan does not trigger */
+#define IIOCAP_SLOPE_SPAN_NS 1000000000ULL
+
+#define IIOCAP_FILE_EXT     ".cap"
+#define IIOCAP_FILE_MODE    0644
+#define IIOCAP_INDEX_FILE   "/captures"
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    IIOCAP_IDLE,
+    IIOCAP_POST,
+} iiocap_state_t;
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u32 pre_ms;
+    u32 post_ms;
+    s32 slope;
+} iiocap_cfg_t;
+
+typedef struct {
+    iiocap_cfg_t cfg;
+    iiocap_state_t state;
+    u64 trig_ns;
+    u64 post_end_ns;
+    /* Oldest record and the number of records held */
+    u32 tail;
+    u32 rec_num;
+    bool ref_set;
+    s64 ref_val;
+    u64 ref_ns;
+    /* Sample time of the newest record pushed */
+    u64 push_ns;
+    /* Capture file, open for the post time */
+    int fd;
+    u64 rec_ns[IIOCAP_RING_REC];
+    u8 *rec;
+} iiocap_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+iiocap_t *iiocap_alloc(const iiocap_cfg_t *cfg);
+usize iiocap_push(iiocap_t *cap, const u8 *rec, usize rec_num, u64 first_ns, u64 last_ns);
+bool iiocap_trigger(iiocap_t *cap, u64 now);
+usize iiocap_drain(iiocap_t *cap, u8 *out, usize rec_max);
+bool iiocap_checkSlope(iiocap_t *cap, s64 val, u64 ts);
+void iiocap_free(iiocap_t *cap);
+
+#endif /* __IIO_CAPTURE_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
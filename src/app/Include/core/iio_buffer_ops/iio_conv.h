@@ -0,0 +1,82 @@
+/**********************************************************************************************************************
+* iio_conv.h                                                                                                          *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the conversion of decoded buffer values into the units of the IIO ABI. The plan of a          *
+*       device holds the shift, the valid bits and the sign of every scan element, taken from its type, and the       *
+*       scale and offset of the channel. It is filled once when the data format is read, the conversion of a          *
+*       batch is a multiply-add per value without any attribute access.                                               *
+*                                                                                                                     *
+*       value = (raw + offset) * scale, e.g. m/s^2 for acceleration, kPa for pressure, mV for voltage                 *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct iioconv_chan_t                                                                                         *
+*                           Conversion of a single scan element                                                       *
+*       struct iioconv_t    Conversion plan of a device, in the channel order of the data format                      *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            iioconv_parseType(iioconv_chan_t *chan, const char *type);                                *
+*       void                iioconv_setScale(iioconv_chan_t *chan, double scale, double offset);                      *
+*       usize               iioconv_toSI(const iioconv_t *conv, const s64 *raw, double *si, usize val_num);           *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __IIO_CONV_H__
+#define __IIO_CONV_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+/* Same as the channels of data_format_t */
+#define IIOCONV_CHAN_MAX    16U
+
+#define IIOCONV_SCALE_SUFFIX    "_scale"
+#define IIOCONV_OFFSET_SUFFIX   "_offset"
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u8 shift;
+    u8 realbits;
+    bool is_signed;
+    /* A scale attribute was read, otherwise the values stay in raw counts */
+    bool scaled;
+    double scale;
+    double offset;
+    /* offset * scale, added after the multiplication */
+    double bias;
+} iioconv_chan_t;
+
+typedef struct {
+    u8 chan_num;
+    iioconv_chan_t chan[IIOCONV_CHAN_MAX];
+} iioconv_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+stdret_t iioconv_parseType(iioconv_chan_t *chan, const char *type);
+void iioconv_setScale(iioconv_chan_t *chan, double scale, double offset);
+usize iioconv_toSI(const iioconv_t *conv, const s64 *raw, double *si, usize val_num);
+
+#endif /* __IIO_CONV_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,59 @@
+/**********************************************************************************************************************
+* iio_scan.h                                                                                                          *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for decoding IIO buffer scans. Shared by hab_master and the post-flight tools,                    *
+*       so it depends on nothing but the standard types.                                                              *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct data_format_t                                                                                          *
+*                           Defines a format how data is represented (for instance in a buffer)                       *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       int                 iioscan_extract(const data_format_t *format, u8 *chan_idx, s64 *dst,                      *
+*                                           const u8 *src, const usize size);                                         *
+*       usize               iioscan_scanSize(const data_format_t *format);                                            *
+*       int                 iioscan_parseHexLine(const char *line, usize len, u8 *record, const char **append,        *
+*                                                usize *append_len);                                                  *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __IIO_SCAN_H__
+#define __IIO_SCAN_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u8 chan_num;
+    u8 storagebits[16];
+    bool ts_en;             /* The last channel is the IIO timestamp, ns of the clock set by the device */
+} data_format_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+int iioscan_extract(const data_format_t *format, u8 *chan_idx, s64 *dst, const u8 *src, const usize size);
+usize iioscan_scanSize(const data_format_t *format);
+int iioscan_parseHexLine(const char *line, usize len, u8 *record, const char **append, usize *append_len);
+
+#endif /* __IIO_SCAN_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
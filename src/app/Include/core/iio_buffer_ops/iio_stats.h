@@ -0,0 +1,109 @@
+/**********************************************************************************************************************
+* iio_stats.h                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the windowed statistics of decoded buffer channels. Every hop scans a summary line with       *
+*       min, max, mean and sample variance of each channel over the last window scans is produced. A window           *
+*       equal to the hop gives tumbling windows, a longer one sliding windows. The window is kept as                  *
+*       window / hop panes updated with Welford's method and merged when the summary is due, so min and max           *
+*       stay exact and a scan is touched once.                                                                        *
+*                                                                                                                     *
+*       Device configuration:                                                                                         *
+*           <stats>                                                                                                   *
+*               <window>                                                                                              *
+*                   <val>scans</val>                                                                                  *
+*               </window>                                                                                             *
+*               <hop>                               - optional, the window by default                                 *
+*                   <val>scans</val>                                                                                  *
+*               </hop>                                                                                                *
+*               <raw>                               - optional, the raw log is only kept with 1                       *
+*                   <val>1</val>                                                                                      *
+*               </raw>                                                                                                *
+*           </stats>                                                                                                  *
+*                                                                                                                     *
+*       Summary line:                                                                                                 *
+*           <last ts ns>,<first ts ns>,<scans>[,<min>,<max>,<mean>,<var>] for every channel                           *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct iiostats_cfg_t                                                                                         *
+*                           Statistics configuration of a device, a zero window disables the stage                    *
+*       struct iiostats_t   Statistics state of a device                                                              *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       iiostats_t *        iiostats_alloc(const u8 chan_num, const iiostats_cfg_t *cfg);                             *
+*       usize               iiostats_push(iiostats_t *st, const s64 *scan, u64 ts, char *out, usize cap);             *
+*       usize               iiostats_header(const iiostats_t *st, char *out, usize cap);                              *
+*       void                iiostats_free(iiostats_t *st);                                                            *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __IIO_STATS_H__
+#define __IIO_STATS_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define IIOSTATS_CHAN_MAX   16U
+/* Longest window in hops, a longer window is cut to that */
+#define IIOSTATS_PANE_MAX   16U
+/* Each channel takes four values of at most 24 characters */
+#define IIOSTATS_LINE_MAX   (64U + IIOSTATS_CHAN_MAX * 4U * 24U)
+
+#define IIOSTATS_FILE_EXT   ".stats.csv"
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u16 window;
+    u16 hop;
+    bool raw;
+} iiostats_cfg_t;
+
+typedef struct {
+    u32 n;
+    double mean;
+    double m2;
+    s64 min;
+    s64 max;
+} iiostats_acc_t;
+
+typedef struct {
+    iiostats_cfg_t cfg;
+    u8 chan_num;
+    u8 pane_num;
+    u8 pane_idx;
+    u8 pane_done;
+    u16 pane_fill;
+    u64 pane_ts[IIOSTATS_PANE_MAX];
+    iiostats_acc_t pane[IIOSTATS_PANE_MAX][IIOSTATS_CHAN_MAX];
+} iiostats_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+iiostats_t *iiostats_alloc(const u8 chan_num, const iiostats_cfg_t *cfg);
+usize iiostats_push(iiostats_t *st, const s64 *scan, u64 ts, char *out, usize cap);
+usize iiostats_header(const iiostats_t *st, char *out, usize cap);
+void iiostats_free(iiostats_t *st);
+
+#endif /* __IIO_STATS_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,72 @@
+/**********************************************************************************************************************
+* iio_discovery.h                                                                                                     *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the name based IIO device discovery. Devices are resolved by their IIO name                   *
+*       (optionally with the I2C address) or by DT label instead of the iio:deviceN probe index.                      *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum iiodisc_fd_t   File descriptors cached per resolved device                                               *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       void                iiodisc_scan(void);                                                                       *
+*       bool                iiodisc_isPresent(const u32 dev_idx);                                                     *
+*       const char *        iiodisc_getSysfsPath(const u32 dev_idx);                                                  *
+*       const char *        iiodisc_getDevfsPath(const u32 dev_idx);                                                  *
+*       int                 iiodisc_getFd(const u32 dev_idx, const iiodisc_fd_t fd_type);                             *
+*       s32                 iiodisc_attach(const char *kobj_name);                                                    *
+*       s32                 iiodisc_detach(const char *kobj_name);                                                    *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __IIO_DISCOVERY_H__
+#define __IIO_DISCOVERY_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define IIO_SYSFS_PATH     "/sys/bus/iio/devices/"
+#define IIO_DEV_KOBJ_BASE  "iio:device"
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    IIODISC_FD_BUFF,
+    IIODISC_FD_DATA_AVAIL,
+    IIODISC_FD_NUM,
+} iiodisc_fd_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+void iiodisc_scan(void);
+bool iiodisc_isPresent(const u32 dev_idx);
+
+const char *iiodisc_getSysfsPath(const u32 dev_idx);
+const char *iiodisc_getDevfsPath(const u32 dev_idx);
+int iiodisc_getFd(const u32 dev_idx, const iiodisc_fd_t fd_type);
+
+s32 iiodisc_attach(const char *kobj_name);
+s32 iiodisc_detach(const char *kobj_name);
+
+#endif /* __IIO_DISCOVERY_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+* log_codec.h                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the columnar log codec. Every channel of a scan is read from its place in the IIO scan        *
+*       and sign extended when its scan type is signed. A channel is stored as the differences to the previous        *
+*       sample, or for slopes like the IIO timestamp, to the line through the first and the last sample of the        *
+*       block. The residuals are bit-packed above their minimum at the width of their range. Every block starts       *
+*       with the raw value of each channel, so a block can be decoded on its own.                                     *
+*                                                                                                                     *
+*       Block layout:                                                                                                 *
+*           u8  magic | u8 chan_num | u8 rec_num | u16 payload_len (LE) | payload                                     *
+*           chan_num - bits 0..6 channels, bit 7 (LOGCODEC_CHAN_TS) when the last one is the IIO timestamp            *
+*           payload - per channel: u8 mode | varint(zigzag(v[0])) | [varint(zigzag(step))] | varint(zigzag(ref))      *
+*                     | r[1..rec_num - 1] - ref, bit-packed LSB first and padded to a whole byte                      *
+*           mode    - bits 0..6 residual width, bit 7 line: r[i] = v[i] - (v[0] + i * step), else v[i] - v[i - 1]     *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum logfmt_t       Log format of a device. Values are aligned with LOGFMT_* in common.mak                    *
+*       struct logcodec_t   Encoder state of a single device                                                          *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       logcodec_t *        logcodec_alloc(const data_format_t *df, const u16 sign_mask);                             *
+*       usize               logcodec_push(logcodec_t *codec, const u8 *scan, u8 *out, usize size);                    *
+*       usize               logcodec_flush(logcodec_t *codec, u8 *out, usize size);                                   *
+*       stdret_t            logcodec_decode(const u8 *src, usize size, usize *used, s64 *dst, u8 *chan, u8 *rec);     *
+*       void                logcodec_free(logcodec_t *codec);                                                         *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __LOG_CODEC_H__
+#define __LOG_CODEC_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include "stdtypes.h"
+#include "iio_scan.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define LOGCODEC_MAGIC      0xD7U
+#define LOGCODEC_HDR_LEN    5U
+#define LOGCODEC_CHAN_MAX   16U
+#define LOGCODEC_CHAN_TS    0x80U
+#define LOGCODEC_BLOCK_REC  128U
+#define LOGCODEC_VARINT_MAX 10U
+#define LOGCODEC_MODE_LINE  0x80U
+#define LOGCODEC_MODE_WIDTH 0x7FU
+/* Shortest hold of a partial block, the writer waits longer when the trigger needs more to fill a block */
+#define LOGCODEC_FLUSH_MS   5000U
+
+/* Worst case size of an encoded block */
+#define LOGCODEC_BLOCK_MAX  (LOGCODEC_HDR_LEN + \
+                             LOGCODEC_CHAN_MAX * (1U + 2U * LOGCODEC_VARINT_MAX + LOGCODEC_BLOCK_REC * sizeof(u64)))
+
+#define LOGCODEC_FILE_EXT   ".dz"
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    LOGFMT_HEX = 0,
+    LOGFMT_DELTA,
+    LOGFMT_ZIP,
+} logfmt_t;
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u8  chan_num;
+    u8  rec_num;
+    u8  scan_len;                       /* Bytes of a scan, see iioscan_scanSize() */
+    u8  offset[LOGCODEC_CHAN_MAX];
+    u8  storagebits[LOGCODEC_CHAN_MAX];
+    u16 sign_mask;                      /* Bit per channel, set for a signed scan type */
+    bool ts_en;
+    s64 col[LOGCODEC_CHAN_MAX][LOGCODEC_BLOCK_REC];
+} logcodec_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+logcodec_t *logcodec_alloc(const data_format_t *df, const u16 sign_mask);
+usize logcodec_push(logcodec_t *codec, const u8 *scan, u8 *out, usize size);
+usize logcodec_flush(logcodec_t *codec, u8 *out, usize size);
+stdret_t logcodec_decode(const u8 *src, usize size, usize *used, s64 *dst, u8 *chan_num, u8 *rec_num);
+void logcodec_free(logcodec_t *codec);
+
+#endif /* __LOG_CODEC_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
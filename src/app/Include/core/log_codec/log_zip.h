@@ -0,0 +1,117 @@
+/**********************************************************************************************************************
+* log_zip.h                                                                                                           *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the log compression stage. Raw scan records of a device are collected into blocks of up       *
+*       to LOGZIP_BLOCK_SIZE bytes which a worker thread compresses and writes to the framed log of the device.       *
+*       Blocks are compressed on their own, so every frame of the log can be decoded on its own.                      *
+*       When the worker falls behind or exceeds HAB_ZIP_CPU_PCT of a core, blocks are stored uncompressed.            *
+*                                                                                                                     *
+*       Block layout:                                                                                                 *
+*           logzip_hdr_t | payload                                                                                    *
+*           payload - LZ4 block format, zstd frame or the raw data, see logzip_method_t                               *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum logzip_method_t                                                                                          *
+*                           Compression method. Values are aligned with ZIP_METHOD_* in common.mak                    *
+*       struct logzip_hdr_t Header of a block                                                                         *
+*       struct logzip_t     Compression stage of a single log                                                         *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       logzip_t *          logzip_open(storage_t *store);                                                            *
+*       stdret_t            logzip_write(logzip_t *zip, const void *buff, usize size);                                *
+*       stdret_t            logzip_flush(logzip_t *zip, const bool force);                                            *
+*       void                logzip_close(logzip_t *zip);                                                              *
+*       usize               logzip_encodeBlock(const u8 *src, usize size, u8 *dst, usize cap, u8 method, u8 level);   *
+*       stdret_t            logzip_decodeBlock(const u8 *src, usize size, u8 *dst, usize cap, usize *raw_len);       *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __LOG_ZIP_H__
+#define __LOG_ZIP_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+#include "storage.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#ifndef HAB_ZIP_METHOD
+# define HAB_ZIP_METHOD     LOGZIP_LZ4
+#endif
+
+/* 1 - fastest, 9 - best ratio */
+#ifndef HAB_ZIP_LEVEL
+# define HAB_ZIP_LEVEL      1
+#endif
+
+#ifndef HAB_ZIP_CPU_PCT
+# define HAB_ZIP_CPU_PCT    50
+#endif
+
+#define LOGZIP_MAGIC        0x5AU
+#define LOGZIP_BLOCK_SIZE   (64U * 1024U)
+/* Worst case size of a block, the stored one */
+#define LOGZIP_BLOCK_MAX    (sizeof(logzip_hdr_t) + LOGZIP_BLOCK_SIZE)
+/* A partially filled block is sealed once it is that old */
+#define LOGZIP_FLUSH_MS     5000U
+#define LOGZIP_QUEUE_LEN    8U
+/* Queued blocks from which on the worker stores instead of compressing */
+#define LOGZIP_BACKOFF_DEPTH (LOGZIP_QUEUE_LEN / 2U)
+
+#define LOGZIP_FILE_EXT     ".lz"
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    LOGZIP_STORED = 0,
+    LOGZIP_LZ4,
+    LOGZIP_ZSTD,
+} logzip_method_t;
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u8  magic;
+    u8  method;
+    u16 rsvd;
+    u32 raw_len;
+} logzip_hdr_t;
+
+typedef struct {
+    storage_t *store;
+    u8 *blk;
+    usize blk_used;
+    u64 blk_ms;
+} logzip_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+logzip_t *logzip_open(storage_t *store);
+stdret_t logzip_write(logzip_t *zip, const void *buff, usize size);
+stdret_t logzip_flush(logzip_t *zip, const bool force);
+void logzip_close(logzip_t *zip);
+usize logzip_encodeBlock(const u8 *src, usize size, u8 *dst, usize cap, u8 method, u8 level);
+stdret_t logzip_decodeBlock(const u8 *src, usize size, u8 *dst, usize cap, usize *raw_len);
+
+#endif /* __LOG_ZIP_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,142 @@
+/**********************************************************************************************************************
+* storage.h                                                                                                           *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the log storage. A log is either a plain append stream, a set of preallocated                 *
+*       segments "<path>.<seq>" that are written through a memory mapping and rotated when full, or a                 *
+*       "<path>.<seq>" file written with O_DIRECT in erase block sized, aligned blocks.                               *
+*       A framed log wraps every write into a storage_frame_t header with a sequence number and CRC32C.               *
+*       When a framed log is opened, a tail scan finds the last valid frame of the latest file, cuts                  *
+*       whatever follows it and appending resumes there.                                                              *
+*       Every log has a sidecar "<path>.idx" of fixed size storage_idx_t entries, one per                             *
+*       STORAGE_IDX_EVERY writes, which lets a reader find a time position with a binary search.                      *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum storage_mode_t Storage backend. Values are aligned with STORAGE_MODE_* in common.mak                     *
+*       struct storage_frame_t                                                                                        *
+*                           Header preceding every write of a framed log                                              *
+*       struct storage_idx_t                                                                                          *
+*                           Sidecar index entry, also used as a position returned by storage_seek()                   *
+*       struct storage_t    Open log                                                                                  *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       storage_t *         storage_open(const char *path, const bool framed);                                        *
+*       stdret_t            storage_write(storage_t *store, const void *buff, usize size);                            *
+*       stdret_t            storage_flush(storage_t *store);                                                          *
+*       void                storage_close(storage_t *store);                                                          *
+*       u32                 storage_frameCrc(const storage_frame_t *frame, const void *payload);                      *
+*       stdret_t            storage_seek(const char *path, u32 run, u64 ts_ms, bool upper, storage_idx_t *pos);       *
+*       void                storage_getFilePath(const char *path, const u32 seg_seq, char *buff, usize size);         *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __STORAGE_H__
+#define __STORAGE_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#ifndef HAB_STORAGE_MODE
+# define HAB_STORAGE_MODE   STORAGE_STREAM
+#endif
+
+#ifndef HAB_STORAGE_BLOCK_KB
+# define HAB_STORAGE_BLOCK_KB 4096
+#endif
+
+/* Size of a preallocated segment, a multiple of the page size */
+#define STORAGE_SEG_SIZE    (4U * 1024U * 1024U)
+/* Period of the blocking sync of the dirty pages of a segment */
+#define STORAGE_MMAP_FLUSH_MS   10000U
+
+/* O_DIRECT mode - erase block sized buffer, flushed in STORAGE_DIRECT_ALIGN units */
+#define STORAGE_BLOCK_SIZE  ((usize)HAB_STORAGE_BLOCK_KB * 1024U)
+#define STORAGE_DIRECT_ALIGN     4096U
+#define STORAGE_DIRECT_FLUSH_MS  10000U
+
+#define STORAGE_FRAME_MAGIC 0x46424148U /* "HABF" */
+/* Frames behind the end of the header chain checked before falling back to a full scan */
+#define STORAGE_SCAN_DEPTH  16U
+
+#define STORAGE_IDX_EXT     ".idx"
+#define STORAGE_IDX_EVERY   16U
+#define STORAGE_SEG_FMT     "%s.%04u"
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    STORAGE_STREAM = 0,
+    STORAGE_MMAP,
+    STORAGE_DIRECT,
+} storage_mode_t;
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    u32 magic;
+    u32 seq;
+    u32 len;
+    u32 crc;    /* CRC32C of seq, len and the payload */
+} storage_frame_t;
+
+typedef struct {
+    u64 ts_ms;      /* habtime_nowNs() in ms, the clock of the IIO timestamps in the records */
+    u32 seg_seq;    /* Segment of the position, 0 for a stream log */
+    u32 run;        /* Earlier opens of the log, the clock starts over with a reboot */
+    u64 offset;     /* Offset of the write inside the segment */
+} storage_idx_t;
+
+typedef struct {
+    storage_mode_t mode;
+    bool  framed;
+    u32   frame_seq;
+    int   fd;
+    u32   seg_seq;
+    usize seg_used;
+    usize seg_synced;
+    u8    *seg_map;
+    u8    *blk;
+    usize blk_used;
+    usize blk_synced;
+    u64   blk_off;
+    u64   flush_ms;
+    u64   stream_off;
+    int   idx_fd;
+    u32   idx_cnt;
+    u32   idx_run;
+    char  path[64];
+} storage_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+storage_t *storage_open(const char *path, const bool framed);
+stdret_t storage_write(storage_t *store, const void *buff, usize size);
+stdret_t storage_flush(storage_t *store);
+void storage_close(storage_t *store);
+u32 storage_frameCrc(const storage_frame_t *frame, const void *payload);
+stdret_t storage_seek(const char *path, const u32 run, const u64 ts_ms, const bool upper, storage_idx_t *pos);
+void storage_getFilePath(const char *path, const u32 seg_seq, char *buff, usize size);
+
+#endif /* __STORAGE_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
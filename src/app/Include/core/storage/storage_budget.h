@@ -0,0 +1,100 @@
+/**********************************************************************************************************************
+* storage_budget.h                                                                                                    *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the storage budget. Written bytes are accounted per data class, the free space of             *
+*       HAB_DATASTORAGE_PATH is polled and the time to full is projected from the write rates. When the card          *
+*       would fill up before HAB_BUDGET_HORIZON_S, the policy degrades in stages, media first, so that                *
+*       high priority sensor logs can always be written. HAB_BUDGET_RESERVE_MB is never given to media.               *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum budget_class_t Class of the accounted data                                                               *
+*       enum budget_level_t Degradation stage, every stage includes the restrictions of the previous ones             *
+*       enum budget_prio_t  Sensor log priority. Values are aligned with LOGPRIO_* in common.mak                      *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            budget_start(uv_loop_t *loop);                                                            *
+*       void                budget_account(const budget_class_t cls, const usize bytes);                              *
+*       budget_level_t      budget_getLevel(void);                                                                    *
+*       bool                budget_allowMedia(const budget_class_t cls);                                              *
+*       u8                  budget_getStillQuality(void);                                                             *
+*       bool                budget_keepSensor(const u32 dev_idx);                                                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __STORAGE_BUDGET_H__
+#define __STORAGE_BUDGET_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <uv.h>
+#include <stdbool.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#ifndef HAB_BUDGET_HORIZON_S
+# define HAB_BUDGET_HORIZON_S  14400
+#endif
+
+#ifndef HAB_BUDGET_RESERVE_MB
+# define HAB_BUDGET_RESERVE_MB 512
+#endif
+
+#define BUDGET_PERIOD_MS       10000U
+/* Video kept out of every BUDGET_VIDEO_DIV requests at BUDGET_FEWER_VIDEOS */
+#define BUDGET_VIDEO_DIV       3U
+/* JPEG quality of stills from BUDGET_LOW_STILLS on, 0 keeps the camera default */
+#define BUDGET_STILL_QUALITY   50U
+/* Batches of a low priority sensor kept out of every BUDGET_DECIMATION from BUDGET_DECIMATE on */
+#define BUDGET_DECIMATION      4U
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    BUDGET_SENSOR,
+    BUDGET_STILL,
+    BUDGET_VIDEO,
+    BUDGET_CLASS_NUM,
+} budget_class_t;
+
+typedef enum {
+    BUDGET_NORMAL,
+    BUDGET_FEWER_VIDEOS,
+    BUDGET_LOW_STILLS,
+    BUDGET_DECIMATE,
+    BUDGET_SENSOR_ONLY,
+} budget_level_t;
+
+typedef enum {
+    BUDGET_PRIO_HIGH,
+    BUDGET_PRIO_LOW,
+} budget_prio_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+stdret_t budget_start(uv_loop_t *loop);
+void budget_account(const budget_class_t cls, const usize bytes);
+budget_level_t budget_getLevel(void);
+bool budget_allowMedia(const budget_class_t cls);
+u8 budget_getStillQuality(void);
+bool budget_keepSensor(const u32 dev_idx);
+
+#endif /* __STORAGE_BUDGET_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
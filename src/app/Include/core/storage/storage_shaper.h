@@ -0,0 +1,61 @@
+/**********************************************************************************************************************
+* storage_shaper.h                                                                                                    *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the I/O shaper. Writes are tagged with their budget_class_t. The class of the calling         *
+*       thread is mapped to an I/O priority, children forked afterwards inherit it, so the sensor logs of the         *
+*       uv loop stay above the media written by the rpicam children. Media classes additionally go through a          *
+*       token bucket of HAB_IO_MEDIA_KBPS with a HAB_IO_MEDIA_BURST_MB depth, which bounds the average card           *
+*       load of the captures.                                                                                         *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       int                 shaper_setThreadClass(const budget_class_t cls);                                          *
+*       void                shaper_restoreThread(const int ioprio);                                                   *
+*       bool                shaper_acquire(const budget_class_t cls);                                                 *
+*       void                shaper_consume(const budget_class_t cls, const usize bytes);                              *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __STORAGE_SHAPER_H__
+#define __STORAGE_SHAPER_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <stdbool.h>
+#include "stdtypes.h"
+#include "storage_budget.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#ifndef HAB_IO_MEDIA_KBPS
+# define HAB_IO_MEDIA_KBPS     1024
+#endif
+
+#ifndef HAB_IO_MEDIA_BURST_MB
+# define HAB_IO_MEDIA_BURST_MB 16
+#endif
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+int shaper_setThreadClass(const budget_class_t cls);
+void shaper_restoreThread(const int ioprio);
+bool shaper_acquire(const budget_class_t cls);
+void shaper_consume(const budget_class_t cls, const usize bytes);
+
+#endif /* __STORAGE_SHAPER_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+* telemetry.h                                                                                                         *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the live telemetry segment. hab_master publishes the latest value, timestamp and status       *
+*       of every channel into the shared memory object TELEM_SHM_NAME, other processes map it read-only.              *
+*       Every device slot is guarded by its own sequence counter, odd while the loop thread rewrites the slot.        *
+*       A reader copies the slot and retries when the counter was odd or moved, so it takes no lock and makes         *
+*       no syscall, and the acquisition loop never waits for a reader.                                                *
+*                                                                                                                     *
+*       Segment layout:                                                                                               *
+*           telem_hdr_t | telem_dev_t[dev_num]                                                                        *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       enum telem_status_t Status of a channel                                                                       *
+*       struct telem_chan_t Latest readout of a channel                                                               *
+*       struct telem_dev_t  Slot of a device, a multiple of a cache line                                              *
+*       struct telem_hdr_t  Header of the segment                                                                     *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            telem_open(void);                                                                         *
+*       void                telem_publish(u8 dev_idx, const s64 *vals, const double *si, u8 chan_num, u64 ts_ns,      *
+*                                         u32 err_mask);                                                              *
+*       void                telem_setStatus(u8 dev_idx, telem_status_t status);                                       *
+*       const telem_hdr_t * telem_attach(void);                                                                       *
+*       stdret_t            telem_snapshot(const telem_hdr_t *hdr, u8 dev_idx, telem_dev_t *dev);                     *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define TELEM_SHM_NAME      "/hab_telemetry"
+#define TELEM_MAGIC         0x4D4C4554U
+#define TELEM_VERSION       2U
+#define TELEM_CHAN_MAX      16U
+/* A snapshot gives up after that many torn copies, the writer holds a slot for a few hundred ns only */
+#define TELEM_READ_TRIES    1000U
+
+/* Slot of a device from the start of the segment */
+#define TELEM_DEV(hdr, idx) ((const telem_dev_t *)((const u8 *)(hdr) + sizeof(telem_hdr_t) + (usize)(idx) * (hdr)->dev_size))
+
+/**********************************************************************************************************************
+ *  TYPEDEF ENUM DECLARATION
+ *********************************************************************************************************************/
+typedef enum {
+    TELEM_NO_DATA = 0,
+    TELEM_OK,
+    TELEM_ERROR,            /* The last readout failed, the value is the last good one */
+} telem_status_t;
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    s64 value;              /* Raw readout */
+    double si;              /* Value in the units of the IIO ABI, the raw count of a channel without a scale */
+    u64 ts_ns;              /* CLOCK_MONOTONIC of the value */
+    u32 status;
+    u32 rsvd;
+} telem_chan_t;
+
+typedef struct {
+    u32 seq;                /* Odd while the slot is written */
+    u32 update_cnt;
+    u64 update_ns;
+    char name[16];
+    u8  chan_num;
+    u8  rsvd[31];
+    telem_chan_t chan[TELEM_CHAN_MAX];
+} telem_dev_t;
+
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 dev_num;
+    u16 dev_size;
+    u16 chan_max;
+    u32 pid;
+    u64 start_ns;
+    u8  rsvd[40];
+} telem_hdr_t;
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+stdret_t telem_open(void);
+void telem_publish(u8 dev_idx, const s64 *vals, const double *si, u8 chan_num, u64 ts_ns, u32 err_mask);
+void telem_setStatus(u8 dev_idx, telem_status_t status);
+
+const telem_hdr_t *telem_attach(void);
+stdret_t telem_snapshot(const telem_hdr_t *hdr, u8 dev_idx, telem_dev_t *dev);
+
+#endif /* __TELEMETRY_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
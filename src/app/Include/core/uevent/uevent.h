@@ -0,0 +1,63 @@
+/**********************************************************************************************************************
+* uevent.h                                                                                                            *
+***********************************************************************************************************************
+* DESCRIPTION :                                                                                                       *
+*       Header file for the kernel uevent monitor. Kernel object notifications are received over netlink              *
+*       and dispatched to the registered listeners from within the uv loop.                                           *
+*                                                                                                                     *
+* PUBLIC TYPEDEFS :                                                                                                   *
+*       struct uevent_t     Parsed kernel uevent                                                                      *
+*                                                                                                                     *
+* PUBLIC FUNCTIONS :                                                                                                  *
+*       stdret_t            uevent_addListener(uv_loop_t *loop, uevent_cb_t cb);                                      *
+*       void                uevent_removeListener(uevent_cb_t cb);                                                    *
+*                                                                                                                     *
+* AUTHOR :                                                                                                            *
+*       Yahor Yauseyenka    email: yahoryauseyenka@gmail.com                                                          *
+*                                                                                                                     *
+* VERSION                                                                                                             *
+*       0.0.1               last modification: 19-10-2026                                                             *
+*                                                                                                                     *
+* LICENSE                                                                                                             *
+*       GPL                                                                                                           *
+*                                                                                                                     *
+***********************************************************************************************************************/
+
+#ifndef __UEVENT_H__
+#define __UEVENT_H__
+
+/**********************************************************************************************************************
+ *  INCLUDES
+ *********************************************************************************************************************/
+#include <uv.h>
+#include "stdtypes.h"
+
+/**********************************************************************************************************************
+ *  PREPROCESSOR DEFINITIONS
+ *********************************************************************************************************************/
+#define UEVENT_ACTION_ADD    "add"
+#define UEVENT_ACTION_REMOVE "remove"
+
+/**********************************************************************************************************************
+ *  TYPEDEF STRUCT DECLARATION
+ *********************************************************************************************************************/
+typedef struct {
+    const char *action;
+    const char *devpath;
+    const char *subsystem;
+    const char *kobj_name;
+} uevent_t;
+
+typedef void (*uevent_cb_t)(const uevent_t *uev);
+
+/**********************************************************************************************************************
+ * GLOBAL FUNCTION DECLARATION
+ *********************************************************************************************************************/
+stdret_t uevent_addListener(uv_loop_t *loop, uevent_cb_t cb);
+void uevent_removeListener(uevent_cb_t cb);
+
+#endif /* __UEVENT_H__ */
+
+/***********************************************************************************************************************
+ * END OF FILE
+ **********************************************************************************************************************/
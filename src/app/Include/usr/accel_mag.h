@@ -0,0 +1,18 @@
+#ifndef __ACCEL_MAG_H__
+#define __ACCEL_MAG_H__
+
+#include "stdtypes.h"
+
+/* Raw counts of 1 g at the +-2 g range */
+#define ACCMAG_1G_RAW           16384U
+/* Squared raw magnitude of a threshold in mg, compared against x^2 + y^2 + z^2 */
+#define ACCMAG_THR_SQ(mg)       ((u32)(((mg) * ACCMAG_1G_RAW / 1000U) * ((mg) * ACCMAG_1G_RAW / 1000U)))
+
+#define ACCMAG_MASK_WORDS(n)    (((n) + 63U) / 64U)
+
+/* Bit i of mask[i / 64] is set for every sample with x^2 + y^2 + z^2 <= thr_sq. Returns the count of set bits. */
+usize accmag_belowMask(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask);
+usize accmag_belowMaskScalar(const s16 *x, const s16 *y, const s16 *z, usize n, u32 thr_sq, u64 *mask);
+const char *accmag_getImpl(void);
+
+#endif /* __ACCEL_MAG_H__ */
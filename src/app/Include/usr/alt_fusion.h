@@ -0,0 +1,17 @@
+#ifndef __ALT_FUSION_H__
+#define __ALT_FUSION_H__
+
+#include "stdtypes.h"
+
+/* Pressures of the lookup table, Pa. Altitudes outside are clamped, roughly -900 m to 45 km. */
+#define ALTFUS_P_MAX_PA         111000U
+#define ALTFUS_P_MIN_PA         200U
+#define ALTFUS_LUT_LEN          256U
+
+/* Builds the barometric table and subscribes to the decoded scans of the pressure sensor and the IMU.
+ * Estimates are published on EV_TOPIC_ALTITUDE after every batch. */
+stdret_t altfus_init(void);
+/* Altitude in mm of a pressure in Pa with 8 fractional bits, table lookup with linear interpolation */
+s32 altfus_pressureToAlt(u32 p_q8);
+
+#endif /* __ALT_FUSION_H__ */
@@ -3,6 +3,16 @@
 
 #include "hab_device_types.h"
 
+/* Published as ev_msg_t.data.flight_phase on EV_TOPIC_FLIGHT_PHASE */
+typedef enum {
+    FFDET_FLIGHT,
+    FFDET_PREFALL,
+    FFDET_FALL,
+    FFDET_PREFLIGHT,
+} ffdet_phase_t;
+
 void ffdet_process_frame(const habdev_t *accel_dev);
+ffdet_phase_t ffdet_getPhase(void);
+const char *ffdet_getPhaseName(const u8 phase);
 
 #endif /* __FREE_FALL_DETECTOR__ */
\ No newline at end of file
@@ -20,12 +20,19 @@ struct icm20x_fields {
     u16 acc_z;
 };
 
+/* Buffer scan, the timestamp is aligned to 8 bytes behind the axes */
+struct icm20x_scan {
+    struct icm20x_fields acc;
+    s64 ts;
+};
+
 struct icm20x_data {
     struct  mutex lock;
     struct  i2c_client *client;
     struct  iio_trigger *trig;
 
     struct  icm20x_fields sshot_data;
+    struct  icm20x_scan scan;
     u16     fifo[2048];
     int     irq;
 };
@@ -67,6 +74,7 @@ static const struct iio_chan_spec icm20x_channels[] = {
         .modified = 1,
         .channel2 = IIO_MOD_X,
         .info_mask_separate = BIT(IIO_CHAN_INFO_RAW),
+        .info_mask_shared_by_type = BIT(IIO_CHAN_INFO_SCALE),
         .scan_index = 0,
         .scan_type = {
             .sign = 's',
@@ -80,6 +88,7 @@ static const struct iio_chan_spec icm20x_channels[] = {
         .modified = 1,
         .channel2 = IIO_MOD_Y,
         .info_mask_separate = BIT(IIO_CHAN_INFO_RAW),
+        .info_mask_shared_by_type = BIT(IIO_CHAN_INFO_SCALE),
         .scan_index = 1,
         .scan_type = {
             .sign = 's',
@@ -93,6 +102,7 @@ static const struct iio_chan_spec icm20x_channels[] = {
         .modified = 1,
         .channel2 = IIO_MOD_Z,
         .info_mask_separate = BIT(IIO_CHAN_INFO_RAW),
+        .info_mask_shared_by_type = BIT(IIO_CHAN_INFO_SCALE),
         .scan_index = 2,
         .scan_type = {
             .sign = 's',
@@ -101,6 +111,7 @@ static const struct iio_chan_spec icm20x_channels[] = {
             .endianness = IIO_CPU,
         },
     },
+    IIO_CHAN_SOFT_TIMESTAMP(3),
 };
 
 static const struct i2c_device_id icm20x_ids[] = {
@@ -163,6 +174,8 @@ static void icm20x_arrange_axis_data(u16 *sample, const unsigned long *scan_chan
 static irqreturn_t icm20x_trigger_handler(int irq, void *p) {
     int ret;
     u16 fifo_len;
+    s64 ts;
+    int sample_num;
     u8 buffer[2];
     struct iio_poll_func *pf = p; 
     struct iio_dev *indio_dev = pf->indio_dev;
@@ -199,12 +212,19 @@ static irqreturn_t icm20x_trigger_handler(int irq, void *p) {
     //     iio_push_to_buffers(indio_dev, &data->fifo[i]);
     // }
 
-    for (int i = 0; i < fifo_len; i += 6) {
-        data->sshot_data.acc_x = (hw_buff_raw[i] << 8)   | (hw_buff_raw[i+1] & 0xFF);
-        data->sshot_data.acc_y = (hw_buff_raw[i+2] << 8) | (hw_buff_raw[i+3] & 0xFF);
-        data->sshot_data.acc_z = (hw_buff_raw[i+4] << 8) | (hw_buff_raw[i+5] & 0xFF);
-        
-        iio_push_to_buffers(indio_dev, &data->sshot_data);
+    /* The FIFO is drained at once, the samples are stamped back from now at the sample period */
+    ts = iio_get_time_ns(indio_dev);
+    sample_num = fifo_len / ICM20X_FIFO_SAMPLE_SIZE;
+
+    for (int i = 0; i < sample_num; i++) {
+        u8 *raw = &hw_buff_raw[i * ICM20X_FIFO_SAMPLE_SIZE];
+
+        data->scan.acc.acc_x = (raw[0] << 8) | (raw[1] & 0xFF);
+        data->scan.acc.acc_y = (raw[2] << 8) | (raw[3] & 0xFF);
+        data->scan.acc.acc_z = (raw[4] << 8) | (raw[5] & 0xFF);
+
+        iio_push_to_buffers_with_timestamp(indio_dev, &data->scan,
+                                           ts - (s64)(sample_num - 1 - i) * ICM20X_ACCEL_PERIOD_NS);
     }
 
 release:
@@ -367,7 +387,7 @@ static int icm20x_init(struct icm20x_data *data) {
 
     /* Filters could be disaled. The SF will be much more bigger then. */
     buffer[0] = ICM20X_REG_ACCEL_CONFIG;
-    ICM20X_MASK_ACCEL_CONFIG_ACCEL_FS_SEL_2G |
+    buffer[1] = ICM20X_MASK_ACCEL_CONFIG_ACCEL_FS_SEL_2G |
                     ICM20X_MASK_ACCEL_CONFIG_ACCEL_FCHOICE_ON;
     ret = reg_ops.write_reg(data->client, buffer, sizeof(buffer));
 
@@ -490,6 +510,13 @@ static int icm20x_read_raw(struct iio_dev *indio_dev, struct iio_chan_spec const
     u16 raw_val;
     struct icm20x_data *data = iio_priv(indio_dev);
 
+    /* The range is fixed to +-2 g by icm20x_init() */
+    if (IIO_CHAN_INFO_SCALE == mask) {
+        *val = 0;
+        *val2 = ICM20X_ACCEL_SCALE_2G_NANO;
+        return IIO_VAL_INT_PLUS_NANO;
+    }
+
     mutex_lock(&data->lock);
     ret = icm20x_read_accel_sshot(data);
     mutex_unlock(&data->lock);
@@ -79,6 +79,9 @@ struct icm20x_reg_ops {
 #define ICM20X_MASK_ACCEL_CONFIG_ACCEL_FS_SEL_2G  0x00
 #define ICM20X_MASK_ACCEL_CONFIG_ACCEL_FCHOICE_ON 0x01
 
+/* m/s^2 per count at +-2 g, 9.80665 / 16384 */
+#define ICM20X_ACCEL_SCALE_2G_NANO  598550
+
 #define ICM20X_MASK_FIFO_RST_ASSERT   0x1Fu
 #define ICM20X_MASK_FIFO_RST_DEASSERT 0x00u
 
@@ -92,5 +95,9 @@ struct icm20x_reg_ops {
 
 #define ICM20X_WORD_SIZE        2
 #define ICM20X_FIFO_SET_SIZE    3
+#define ICM20X_FIFO_SAMPLE_SIZE (ICM20X_WORD_SIZE * ICM20X_FIFO_SET_SIZE)
+
+/* 1.125 kHz / (1 + ACCEL_SMPLRT_DIV), the divider is set to 3 by icm20x_init() */
+#define ICM20X_ACCEL_PERIOD_NS  (4LL * NSEC_PER_SEC / 1125)
 
 #endif /* __IIO_DRIVER_ICM20X__ */
\ No newline at end of file